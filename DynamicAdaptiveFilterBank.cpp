@@ -0,0 +1,381 @@
+#include "DynamicAdaptiveFilterBank.h"
+#include <string.h>
+#include <algorithm>
+
+// Zustand eines Kanals in der aktuellen Zeile
+enum LaneGate {
+  LANE_IDLE = 0,    // Kanal nicht in der Zeile
+  LANE_ACTIVE = 1,
+  LANE_OUTLIER = 2  // Von der Hampel-Vorstufe verworfen
+};
+
+// Bitweise Auswahl über eine Lane-Maske (0 oder ~0u). Ein "x = c ? neu : x"
+// würde der Compiler in einen bedingten Store umbauen, der nicht vektorisiert.
+static inline uint32_t laneMask(bool condition) {
+  return 0u - static_cast<uint32_t>(condition);
+}
+
+static inline uint32_t selectLane(uint32_t mask, uint32_t a, uint32_t b) {
+  return (a & mask) | (b & ~mask);
+}
+
+static inline float selectLane(uint32_t mask, float a, float b) {
+  uint32_t ua, ub;
+  memcpy(&ua, &a, sizeof(ua));
+  memcpy(&ub, &b, sizeof(ub));
+  uint32_t r = selectLane(mask, ua, ub);
+  float out;
+  memcpy(&out, &r, sizeof(out));
+  return out;
+}
+
+DynamicAdaptiveFilterBank::DynamicAdaptiveFilterBank(const std::vector<FilterConfig>& configs)
+  : _configs(configs), _fallback(fallbackConfigs(configs)) {
+  _outputs.assign(configs.size(), 0.0f);
+}
+
+bool DynamicAdaptiveFilterBank::isBanked(const FilterConfig& config) {
+  if (config.mode != VALUE_MODE) return false;
+#if defined(DAF_FIXED_POINT)
+  return false; // Die SoA-Zeilen rechnen in float, im Festkomma-Build rechnet DynamicAdaptiveFilterV2
+#endif
+#if defined(USE_KALMAN)
+  if (config.type == KALMAN) return true;
+#endif
+  return config.type == EMA;
+}
+
+std::vector<FilterConfig> DynamicAdaptiveFilterBank::fallbackConfigs(const std::vector<FilterConfig>& configs) {
+  std::vector<FilterConfig> rest;
+  for (size_t i = 0; i < configs.size(); ++i) {
+    if (!isBanked(configs[i])) rest.push_back(configs[i]);
+  }
+  return rest;
+}
+
+void DynamicAdaptiveFilterBank::begin() {
+  _fallback.begin();
+
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, HIGH);
+  _ema = Group();
+#if defined(USE_KALMAN)
+  _kalman = Group();
+#endif
+  _fallbackChannel.clear();
+  for (size_t i = 0; i < _configs.size(); ++i) {
+    const FilterConfig& config = _configs[i];
+    if (!isBanked(config)) {
+      _fallbackChannel.push_back(static_cast<uint32_t>(i));
+      continue;
+    }
+    if (!DynamicAdaptiveFilterV2::validateConfig(config)) {
+      digitalWrite(LED_BUILTIN, LOW);
+      while (true);
+    }
+#if defined(USE_KALMAN)
+    if (config.type == KALMAN) {
+      addToGroup(_kalman, i, config);
+      continue;
+    }
+#endif
+    addToGroup(_ema, i, config);
+  }
+  for (size_t j = 0; j < _fallbackChannel.size(); ++j) {
+    _outputs[_fallbackChannel[j]] = _fallback.getFilteredValue(j);
+  }
+  digitalWrite(LED_BUILTIN, LOW);
+}
+
+// Initialwerte wie DynamicAdaptiveFilterV2::initFilter()
+void DynamicAdaptiveFilterBank::addToGroup(Group& group, size_t channel, const FilterConfig& config) {
+  float normalFreqHz = max(0.01f, config.normalFreqHz);
+  uint32_t expectedIntervalMs = static_cast<uint32_t>(1000.0f / normalFreqHz);
+  size_t lane = group.size();
+
+  group.contiguous = lane == 0 || (group.contiguous && group.channel.back() + 1 == channel);
+  group.channel.push_back(static_cast<uint32_t>(channel));
+  group.filteredValue.push_back(0.0f);
+  group.lastPushTime.push_back(0);
+  group.pushed.push_back(0);
+  group.minDeltaT.push_back(expectedIntervalMs / 2);
+  group.expectedIntervalMs.push_back(expectedIntervalMs);
+  group.maxDecayTimeMs.push_back(static_cast<uint32_t>(max(1000UL, config.maxDecayTimeMs)));
+  group.thresholdPercent.push_back(max(0.0f, config.thresholdPercent));
+  group.baseAlpha.push_back(2.0f / (max(1, config.length) + 1.0f));
+#if defined(USE_KALMAN)
+  group.x.push_back(config.type == KALMAN ? config.initialState : 0.0f);
+  group.P.push_back(1.0f);
+  group.Q.push_back(config.Q);
+  group.R.push_back(config.R);
+#endif
+  if (config.madThreshold > 0.0f) {
+    group.madLane.push_back(static_cast<uint32_t>(lane));
+    group.madThreshold.push_back(config.madThreshold);
+    group.madWindow.push_back(StreamingMAD());
+    group.madWindow.back().reset(MAD_WINDOW_LENGTH);
+  }
+  group.input.push_back(0.0f);
+  group.gate.push_back(LANE_IDLE);
+  _outputs[channel] = 0.0f;
+}
+
+bool DynamicAdaptiveFilterBank::pushSensorData(const SensorData& data) {
+  SensorHandle handle = data.sensorId.length() == 0 ? INVALID_SENSOR_HANDLE : _sensors.find(data.sensorId);
+  if (handle != INVALID_SENSOR_HANDLE) {
+    return pushSensor(handle, data.values.data(), data.values.size(), data.timestamp);
+  }
+  return pushSamples(data.values.data(), data.values.size(), data.timestamp, 0);
+}
+
+SensorHandle DynamicAdaptiveFilterBank::registerSensor(const String& sensorId, size_t firstChannel, size_t channelCount) {
+  return _sensors.add(sensorId, firstChannel, channelCount, _outputs.size());
+}
+
+SensorHandle DynamicAdaptiveFilterBank::sensorHandle(const String& sensorId) const {
+  return _sensors.find(sensorId);
+}
+
+bool DynamicAdaptiveFilterBank::pushSensor(SensorHandle handle, const float* values, size_t count, unsigned long timestamp) {
+  const SensorRegistry::Route* route = _sensors.route(handle);
+  if (route == nullptr || count > route->channelCount) {
+    return false;
+  }
+  return pushSamples(values, count, timestamp, route->firstChannel);
+}
+
+bool DynamicAdaptiveFilterBank::pushSamples(const float* values, size_t count, unsigned long timestamp, size_t firstChannel) {
+  if (values == nullptr || count == 0 || firstChannel >= _outputs.size() || count > _outputs.size() - firstChannel) {
+    return false;
+  }
+
+  unsigned long currentTime = timestamp == 0 ? millis() : timestamp;
+  uint32_t now = static_cast<uint32_t>(currentTime);
+  size_t outliers = 0;
+
+  if (_ema.size() > 0) {
+    outliers += gatherRow(_ema, values, count, firstChannel, now);
+    updateEMARow(_ema, now);
+    scatterRow(_ema);
+  }
+#if defined(USE_KALMAN)
+  if (_kalman.size() > 0) {
+    outliers += gatherRow(_kalman, values, count, firstChannel, now);
+    updateKalmanRow(_kalman, now);
+    scatterRow(_kalman);
+  }
+#endif
+
+  // Nicht gebankte Kanäle in zusammenhängenden Läufen an die Fallback-Instanz
+  size_t j = 0;
+  while (j < _fallbackChannel.size()) {
+    size_t rel = _fallbackChannel[j] - firstChannel;
+    if (_fallbackChannel[j] < firstChannel || rel >= count) {
+      ++j;
+      continue;
+    }
+    size_t run = 1;
+    while (j + run < _fallbackChannel.size() && _fallbackChannel[j + run] == _fallbackChannel[j] + run && rel + run < count) {
+      ++run;
+    }
+    if (!_fallback.pushSamples(values + rel, run, currentTime, j)) {
+      outliers++;
+    }
+    for (size_t r = 0; r < run; ++r) {
+      _outputs[_fallbackChannel[j + r]] = _fallback.getFilteredValue(j + r);
+    }
+    j += run;
+  }
+  return outliers == 0;
+}
+
+// Zeile in den Arbeitsspeicher der Gruppe holen; Hampel-Vorstufe skalar nur
+// für Kanäle mit madThreshold > 0. Rückgabe: Anzahl verworfener Ausreißer.
+size_t DynamicAdaptiveFilterBank::gatherRow(Group& group, const float* values, size_t count, size_t firstChannel, uint32_t now) {
+  size_t n = group.size();
+  size_t first = group.channel[0];
+  if (group.contiguous && first >= firstChannel && first - firstChannel + n <= count) {
+    // Häufigster Fall: alle Kanäle der Gruppe liegen am Stück in der Zeile
+    memcpy(group.input.data(), values + (first - firstChannel), n * sizeof(float));
+    for (size_t k = 0; k < n; ++k) group.gate[k] = LANE_ACTIVE;
+  } else {
+    for (size_t k = 0; k < n; ++k) {
+      size_t rel = group.channel[k] - firstChannel;
+      bool inRange = group.channel[k] >= firstChannel && rel < count;
+      group.gate[k] = inRange ? LANE_ACTIVE : LANE_IDLE;
+      group.input[k] = inRange ? values[rel] : 0.0f;
+    }
+  }
+
+  size_t outliers = 0;
+  for (size_t m = 0; m < group.madLane.size(); ++m) {
+    size_t k = group.madLane[m];
+    if (group.gate[k] == LANE_IDLE) continue;
+    uint32_t deltaT = pushDeltaT(now, group.lastPushTime[k], group.pushed[k] != 0);
+    if (deltaT < group.minDeltaT[k]) continue; // Raten-Gate kommt vor der Hampel-Stufe
+    StreamingMAD& window = group.madWindow[m];
+    float value = group.input[k];
+    window.push(value);
+    if (filterIsOutlier(window, group.madThreshold[m], value)) {
+      group.gate[k] = LANE_OUTLIER;
+      outliers++;
+    }
+  }
+  return outliers;
+}
+
+// Verzweigungsfreie Schleifen: Gate, decayFactor und Schmitt-Trigger als Masken.
+// Als freie Funktionen mit __restrict, damit der Compiler ohne Alias-Prüfungen
+// vektorisieren kann.
+static void emaRowKernel(size_t n, uint32_t now, const float* __restrict input, const uint32_t* __restrict gate,
+                         const uint32_t* __restrict minDeltaT, const uint32_t* __restrict expected,
+                         const uint32_t* __restrict maxDecay, const float* __restrict threshold,
+                         const float* __restrict baseAlpha, uint32_t* __restrict lastPushTime,
+                         uint32_t* __restrict pushed, float* __restrict filtered) {
+  for (size_t k = 0; k < n; ++k) {
+    uint32_t last = lastPushTime[k];
+    uint32_t deltaT = selectLane(pushed[k], elapsedSince(now, last), now - last); // pushDeltaT()
+    uint32_t timely = laneMask((gate[k] != LANE_IDLE) & (deltaT >= minDeltaT[k]));
+    lastPushTime[k] = selectLane(timely, now, last);
+    pushed[k] |= timely;
+
+    float ramp = static_cast<float>(static_cast<int32_t>(deltaT - expected[k])) /
+                 static_cast<float>(static_cast<int32_t>(maxDecay[k] - expected[k]));
+    float decayFactor = selectLane(laneMask(deltaT <= expected[k]), 1.0f,
+                                   selectLane(laneMask(deltaT >= maxDecay[k]), 0.0f, 1.0f - ramp));
+
+    float value = input[k];
+    float f = filtered[k];
+    float af = fabsf(f);
+    uint32_t significant = laneMask(threshold[k] == 0.0f) | laneMask(af < 1e-6f) |
+                           laneMask(fabsf(value - f) / af * 100.0f >= threshold[k]);
+    uint32_t apply = timely & significant & laneMask(gate[k] == LANE_ACTIVE);
+
+    float effectiveAlpha = 1.0f - decayFactor * (1.0f - baseAlpha[k]);
+    float updated = effectiveAlpha * value + (1.0f - effectiveAlpha) * f;
+    filtered[k] = selectLane(apply, updated, f);
+  }
+}
+
+void DynamicAdaptiveFilterBank::updateEMARow(Group& group, uint32_t now) {
+  emaRowKernel(group.size(), now, group.input.data(), group.gate.data(), group.minDeltaT.data(),
+               group.expectedIntervalMs.data(), group.maxDecayTimeMs.data(), group.thresholdPercent.data(),
+               group.baseAlpha.data(), group.lastPushTime.data(), group.pushed.data(), group.filteredValue.data());
+}
+
+#if defined(USE_KALMAN)
+static void kalmanRowKernel(size_t n, uint32_t now, const float* __restrict input, const uint32_t* __restrict gate,
+                            const uint32_t* __restrict minDeltaT, const float* __restrict threshold,
+                            const float* __restrict Q, const float* __restrict R, uint32_t* __restrict lastPushTime,
+                            uint32_t* __restrict pushed, float* __restrict filtered, float* __restrict x, float* __restrict P) {
+  for (size_t k = 0; k < n; ++k) {
+    uint32_t last = lastPushTime[k];
+    uint32_t deltaT = selectLane(pushed[k], elapsedSince(now, last), now - last); // pushDeltaT()
+    uint32_t timely = laneMask((gate[k] != LANE_IDLE) & (deltaT >= minDeltaT[k]));
+    lastPushTime[k] = selectLane(timely, now, last);
+    pushed[k] |= timely;
+
+    float value = input[k];
+    float f = filtered[k];
+    float af = fabsf(f);
+    uint32_t significant = laneMask(threshold[k] == 0.0f) | laneMask(af < 1e-6f) |
+                           laneMask(fabsf(value - f) / af * 100.0f >= threshold[k]);
+    uint32_t apply = timely & significant & laneMask(gate[k] == LANE_ACTIVE);
+
+    float xOld = x[k];
+    float pOld = P[k];
+    float K = pOld * (1.0f / (pOld + R[k]));
+    float xNew = xOld + K * (value - xOld);
+    float pNew = (1.0f - K) * pOld + Q[k];
+    x[k] = selectLane(apply, xNew, xOld);
+    P[k] = selectLane(apply, pNew, pOld);
+    filtered[k] = selectLane(apply, xNew, f);
+  }
+}
+
+void DynamicAdaptiveFilterBank::updateKalmanRow(Group& group, uint32_t now) {
+  kalmanRowKernel(group.size(), now, group.input.data(), group.gate.data(), group.minDeltaT.data(),
+                  group.thresholdPercent.data(), group.Q.data(), group.R.data(), group.lastPushTime.data(),
+                  group.pushed.data(), group.filteredValue.data(), group.x.data(), group.P.data());
+}
+#endif
+
+void DynamicAdaptiveFilterBank::scatterRow(const Group& group) {
+  if (group.contiguous) {
+    memcpy(&_outputs[group.channel[0]], group.filteredValue.data(), group.size() * sizeof(float));
+    return;
+  }
+  for (size_t k = 0; k < group.size(); ++k) {
+    _outputs[group.channel[k]] = group.filteredValue[k];
+  }
+}
+
+int DynamicAdaptiveFilterBank::fallbackIndex(int channel) const {
+  if (channel < 0) return -1;
+  std::vector<uint32_t>::const_iterator it =
+    std::lower_bound(_fallbackChannel.begin(), _fallbackChannel.end(), static_cast<uint32_t>(channel));
+  if (it == _fallbackChannel.end() || *it != static_cast<uint32_t>(channel)) return -1;
+  return static_cast<int>(it - _fallbackChannel.begin());
+}
+
+void DynamicAdaptiveFilterBank::onPulse(int channel) {
+  int j = fallbackIndex(channel);
+  if (j < 0) return;
+  _fallback.onPulse(j);
+}
+
+void DynamicAdaptiveFilterBank::onPulses(int channel, unsigned long count) {
+  int j = fallbackIndex(channel);
+  if (j < 0) return;
+  _fallback.onPulses(j, count);
+}
+
+unsigned long DynamicAdaptiveFilterBank::getCPM(int channel) {
+  int j = fallbackIndex(channel);
+  if (j < 0) return 0;
+  return _fallback.getCPM(j);
+}
+
+unsigned long DynamicAdaptiveFilterBank::getCPM(int channel, unsigned long windowMs) {
+  int j = fallbackIndex(channel);
+  if (j < 0) return 0;
+  return _fallback.getCPM(j, windowMs);
+}
+
+void DynamicAdaptiveFilterBank::updateCPMWindow(int channel, unsigned long windowMs) {
+  int j = fallbackIndex(channel);
+  if (j < 0) return;
+  _fallback.updateCPMWindow(j, windowMs);
+}
+
+unsigned long DynamicAdaptiveFilterBank::getPulseCount(int channel) const {
+  int j = fallbackIndex(channel);
+  if (j < 0) return 0;
+  return _fallback.getPulseCount(j);
+}
+
+std::vector<float> DynamicAdaptiveFilterBank::getFilteredValues() const {
+  return _outputs;
+}
+
+float DynamicAdaptiveFilterBank::getFilteredValue(int channel) const {
+  if (channel < 0 || channel >= (int)_outputs.size()) return 0.0f;
+  return _outputs[channel];
+}
+
+size_t DynamicAdaptiveFilterBank::copyFilteredValues(float* dst, size_t n) const {
+  if (dst == nullptr) return 0;
+  size_t count = min(n, _outputs.size());
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = _outputs[i];
+  }
+  return count;
+}
+
+size_t DynamicAdaptiveFilterBank::bankedChannelCount() const {
+  size_t n = _ema.size();
+#if defined(USE_KALMAN)
+  n += _kalman.size();
+#endif
+  return n;
+}
@@ -0,0 +1,117 @@
+#ifndef DYNAMIC_ADAPTIVE_FILTER_BANK_H
+#define DYNAMIC_ADAPTIVE_FILTER_BANK_H
+
+#include "DynamicAdaptiveFilterV2.h"
+#include <stdint.h>
+
+// Kanalbank mit Structure-of-Arrays-Layout für viele gleichartige Kanäle.
+//
+// EMA- und (mit USE_KALMAN) skalare Kalman-Kanäle im VALUE_MODE werden nach
+// Typ gruppiert; jede Gruppe hält filteredValue, baseAlpha, lastPushTime,
+// P, x, ... in eigenen, zusammenhängenden Arrays. Eine Zeile (SensorData)
+// wird je Gruppe in einer verzweigungsfreien Schleife verarbeitet, die der
+// Compiler vektorisiert. Raten-Gate, decayFactor, Hampel-Vorstufe und
+// Schmitt-Trigger verhalten sich pro Sample wie in DynamicAdaptiveFilterV2.
+//
+// Alle übrigen Kanäle (SMA, FIR, LMS, RLS, DECIMATE, BIQUAD, COUNT_MODE) laufen unverändert
+// über eine interne DynamicAdaptiveFilterV2-Instanz, im DAF_FIXED_POINT-Build
+// alle Kanäle. Kanalnummern und Ausgaben sind dieselben wie bei
+// DynamicAdaptiveFilterV2.
+//
+// Die API ist nur die unten deklarierte Teilmenge. Nicht vorhanden sind:
+//   pushBlock(), pushSamples() mit std::array/std::span
+//   updateNormalFreq(), updateLength(), updateFIRCoeffs(), updateBiquadCoeffs(),
+//   updateMaxDecayTime(), updateThreshold(), updateDeadTime(), updateMode()
+//   snapshotSize(), saveSnapshot(), restoreSnapshot()
+//   getStats(), resetStats() (DAF_ENABLE_STATS)
+// Konfiguration also nur über den Konstruktor; FilterIngest (FilterIngest.h)
+// und Snapshots (filter/Snapshot.h) arbeiten nur mit DynamicAdaptiveFilterV2.
+// Tabellen prüft DynamicAdaptiveFilterV2::validateConfig().
+//
+// Zeitstempel werden intern als 32 Bit (millis()) geführt.
+class DynamicAdaptiveFilterBank {
+public:
+  DynamicAdaptiveFilterBank(const std::vector<FilterConfig>& configs);
+  void begin();
+  bool pushSensorData(const SensorData& data);
+  // Sensor-Handles wie DynamicAdaptiveFilterV2::registerSensor()/pushSensor()
+  SensorHandle registerSensor(const String& sensorId, size_t firstChannel, size_t channelCount);
+  SensorHandle sensorHandle(const String& sensorId) const;
+  bool pushSensor(SensorHandle handle, const float* values, size_t count, unsigned long timestamp = 0);
+  template <size_t N>
+  bool pushSensor(SensorHandle handle, const std::array<float, N>& values, unsigned long timestamp = 0) {
+    return pushSensor(handle, values.data(), N, timestamp);
+  }
+  // values[i] geht an Kanal firstChannel + i; timestamp == 0 -> millis().
+  // false bei ungültigem Bereich oder verworfenem Ausreißer.
+  bool pushSamples(const float* values, size_t count, unsigned long timestamp = 0, size_t firstChannel = 0);
+
+  // COUNT_MODE: Pulse und CPM wie DynamicAdaptiveFilterV2, weitergereicht an
+  // die Fallback-Instanz. Gebankte Kanäle (VALUE_MODE) zählen keine Pulse.
+  void onPulse(int channel);
+  void onPulses(int channel, unsigned long count);
+  unsigned long getCPM(int channel);
+  unsigned long getCPM(int channel, unsigned long windowMs);
+  void updateCPMWindow(int channel, unsigned long windowMs);
+  unsigned long getPulseCount(int channel) const;
+
+  std::vector<float> getFilteredValues() const;
+  float getFilteredValue(int channel) const;
+  size_t copyFilteredValues(float* dst, size_t n) const;
+  const float* filteredValues() const { return _outputs.data(); }
+  size_t channelCount() const { return _outputs.size(); }
+  size_t bankedChannelCount() const; // Kanäle im SoA-Pfad
+
+private:
+  // Eine Gruppe gleichartiger Kanäle, ein Array pro Zustandsgröße
+  struct Group {
+    std::vector<uint32_t> channel;
+    std::vector<float> filteredValue;
+    std::vector<uint32_t> lastPushTime;
+    std::vector<uint32_t> pushed;           // Lane-Maske: mindestens ein Sample angenommen
+    std::vector<uint32_t> minDeltaT;        // expectedIntervalMs / 2
+    std::vector<uint32_t> expectedIntervalMs;
+    std::vector<uint32_t> maxDecayTimeMs;
+    std::vector<float> thresholdPercent;
+    std::vector<float> baseAlpha;           // EMA
+    std::vector<float> x;                   // Kalman
+    std::vector<float> P;
+    std::vector<float> Q;
+    std::vector<float> R;
+    // Hampel-Vorstufe nur für Kanäle mit madThreshold > 0 (skalar)
+    std::vector<uint32_t> madLane;
+    std::vector<float> madThreshold;
+    std::vector<StreamingMAD> madWindow;
+    // Arbeitsspeicher für eine Zeile, einmalig in begin() angelegt
+    std::vector<float> input;
+    std::vector<uint32_t> gate;             // Zeilenzustand je Kanal (LaneGate)
+
+    bool contiguous;                        // Kanäle lückenlos aufsteigend
+
+    Group() : contiguous(false) {}
+    size_t size() const { return channel.size(); }
+  };
+
+  std::vector<FilterConfig> _configs;
+  Group _ema;
+#if defined(USE_KALMAN)
+  Group _kalman;
+#endif
+  DynamicAdaptiveFilterV2 _fallback;        // Alle nicht gebankten Kanäle
+  std::vector<uint32_t> _fallbackChannel;   // Fallback-Index -> Kanal
+  std::vector<float> _outputs;
+  SensorRegistry _sensors;
+
+  static bool isBanked(const FilterConfig& config);
+  int fallbackIndex(int channel) const;     // -1, wenn der Kanal gebankt oder ungültig ist
+  static std::vector<FilterConfig> fallbackConfigs(const std::vector<FilterConfig>& configs);
+  void addToGroup(Group& group, size_t channel, const FilterConfig& config);
+  size_t gatherRow(Group& group, const float* values, size_t count, size_t firstChannel, uint32_t now);
+  void updateEMARow(Group& group, uint32_t now);
+#if defined(USE_KALMAN)
+  void updateKalmanRow(Group& group, uint32_t now);
+#endif
+  void scatterRow(const Group& group);
+};
+
+#endif
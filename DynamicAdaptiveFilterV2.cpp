@@ -1,8 +1,13 @@
 #include "DynamicAdaptiveFilterV2.h"
-#include <algorithm>
 
 DynamicAdaptiveFilterV2::DynamicAdaptiveFilterV2(const std::vector<FilterConfig>& configs) : _configs(configs) {
   _filters.resize(configs.size());
+  _outputs.assign(configs.size(), 0.0f);
+}
+
+DynamicAdaptiveFilterV2::DynamicAdaptiveFilterV2(const FilterConfig* configs, size_t count) : _configs(configs, count) {
+  _filters.resize(count);
+  _outputs.assign(count, 0.0f);
 }
 
 void DynamicAdaptiveFilterV2::begin() {
@@ -14,38 +19,11 @@ void DynamicAdaptiveFilterV2::begin() {
       while (true);
     }
     initFilter(_filters[i], _configs[i]);
+    _outputs[i] = _filters[i].filteredValue;
   }
   digitalWrite(LED_BUILTIN, LOW);
 }
 
-bool DynamicAdaptiveFilterV2::validateConfig(const FilterConfig& config) {
-  if (config.normalFreqHz <= 0 || config.thresholdPercent < 0 || config.deadTimeUs < 0 || config.maxDecayTimeMs < 1000) {
-    return false;
-  }
-  if (config.type == FIR && (config.coeffs == nullptr || config.numCoeffs <= 0)) {
-    return false;
-  }
-  if (config.type == EMA || config.type == SMA) {
-    if (config.length < 1) return false;
-  }
-#if defined(USE_KALMAN)
-  if (config.type == KALMAN && (config.Q <= 0 || config.R <= 0)) {
-    return false;
-  }
-#endif
-#if defined(USE_LMS)
-  if (config.type == LMS && (config.mu <= 0 || config.length > MAX_FILTER_LENGTH || config.length < 1)) {
-    return false;
-  }
-#endif
-#if defined(USE_RLS)
-  if (config.type == RLS && (config.lambda <= 0 || config.lambda > 1 || config.length > MAX_FILTER_LENGTH || config.length < 1)) {
-    return false;
-  }
-#endif
-  return true;
-}
-
 void DynamicAdaptiveFilterV2::initFilter(FilterState& state, const FilterConfig& config) {
   state.type = config.type;
   state.normalFreqHz = max(0.01f, config.normalFreqHz);
@@ -57,166 +35,370 @@ void DynamicAdaptiveFilterV2::initFilter(FilterState& state, const FilterConfig&
   state.mode = config.mode;
   state.startTime = millis();
   state.lastPushTime = 0;
+  state.pushed = false;
   state.filteredValue = 0.0f;
   state.pulseCount = 0;
+  state.pulseWindow.reset(config.mode == COUNT_MODE ? CPM_WINDOW_BUCKETS : 0, state.startTime);
+  state.cpmWindowMs = CPM_DEFAULT_WINDOW_MS;
+#if defined(DAF_FIXED_POINT)
+  state.fixedScale = 0.0f;
+  state.fixedInvScale = 0.0f;
+  state.fixedValue = 0;
+#endif
+
+  bool useMad = config.madThreshold > 0.0f;
+#if defined(USE_LMS)
+  useMad = useMad || config.type == LMS; // LMS nutzt die MAD zusätzlich für die Schrittweite
+#endif
+  state.madWindow.reset(useMad ? MAD_WINDOW_LENGTH : 0);
+  state.decimator.clear();
+  state.biquadCoeffs.clear();
+  state.biquadState.clear();
+  state.biquadOffset = 0.0f;
+  state.biquadGain = 0.0f;
+  state.biquadPrimed = false;
 
   if (config.type == EMA) {
+#if defined(DAF_FIXED_POINT)
+    state.baseAlpha = floatToQ31(2.0f / (max(1, config.length) + 1.0f));
+#else
     state.baseAlpha = 2.0f / (max(1, config.length) + 1.0f);
+#endif
   } else if (config.type == SMA) {
     initSMA(state, max(1, config.length));
   } else if (config.type == FIR) {
     initFIR(state, config.coeffs, config.numCoeffs);
+  } else if (config.type == DECIMATE) {
+    state.decimator.reset(config.coeffs, config.numCoeffs, config.decimation, config.cicStages, config.cicDecimation,
+                          config.fullScale);
+  } else if (config.type == BIQUAD) {
+    initBiquad(state, config.coeffs, config.numCoeffs);
   }
 #if defined(USE_KALMAN)
   else if (config.type == KALMAN) {
+#if defined(DAF_FIXED_POINT)
+    state.P = floatToUQ24(1.0f / config.R);
+    state.Q = floatToUQ24(config.Q / config.R);
+    state.x = 0; // initialState folgt mit dem Vollausschlag, siehe initFixedScale()
+#else
     state.P = 1.0f;
     state.x = config.initialState;
+#endif
   }
 #endif
 #if defined(USE_LMS)
   else if (config.type == LMS) {
-    if (config.mu <= 0) {
-      const_cast<FilterConfig&>(config).mu = 0.01f;
-    }
-    for (int i = 0; i < config.length; i++) {
-      state.coeffs[i] = 0.0f;
-      state.inputBuffer[i] = 0.0f;
+    for (int i = 0; i < MAX_FILTER_LENGTH; i++) {
+      state.coeffs[i] = 0;
+      state.inputBuffer[i] = 0;
+      state.inputBuffer[i + MAX_FILTER_LENGTH] = 0;
     }
     state.bufferIndex = 0;
   }
 #endif
 #if defined(USE_RLS)
   else if (config.type == RLS) {
-    if (config.lambda <= 0 || config.lambda > 1) {
-      const_cast<FilterConfig&>(config).lambda = 0.9f;
-    }
-    for (int i = 0; i < config.length; i++) {
+    for (int i = 0; i < MAX_FILTER_LENGTH; i++) {
       state.coeffs[i] = 0.0f;
       state.inputBuffer[i] = 0.0f;
+      state.inputBuffer[i + MAX_FILTER_LENGTH] = 0.0f;
     }
     state.bufferIndex = 0;
-    state.P = 1.0f;
+    rlsReset(state.P, config.length);
   }
 #endif
 }
 
-float DynamicAdaptiveFilterV2::calculateMAD(float* data, int windowSize) {
-  if (windowSize <= 0) return 0.0f;
-
-  float* temp = new float[windowSize];
-  if (!temp) return 0.0f;
-  for (int i = 0; i < windowSize; i++) {
-    temp[i] = data[i];
+bool DynamicAdaptiveFilterV2::pushSensorData(const SensorData& data) {
+  SensorHandle handle = data.sensorId.length() == 0 ? INVALID_SENSOR_HANDLE : _sensors.find(data.sensorId);
+  if (handle != INVALID_SENSOR_HANDLE) {
+    return pushSensor(handle, data.values.data(), data.values.size(), data.timestamp);
   }
+  return pushSamples(data.values.data(), data.values.size(), data.timestamp, 0);
+}
 
-  std::sort(temp, temp + windowSize);
-  float median = (windowSize % 2 == 0) ?
-    (temp[windowSize/2 - 1] + temp[windowSize/2]) / 2.0f :
-    temp[windowSize/2];
-
-  for (int i = 0; i < windowSize; i++) {
-    temp[i] = abs(temp[i] - median);
-  }
+SensorHandle DynamicAdaptiveFilterV2::registerSensor(const String& sensorId, size_t firstChannel, size_t channelCount) {
+  return _sensors.add(sensorId, firstChannel, channelCount, _filters.size());
+}
 
-  std::sort(temp, temp + windowSize);
-  float mad = (windowSize % 2 == 0) ?
-    (temp[windowSize/2 - 1] + temp[windowSize/2]) / 2.0f :
-    temp[windowSize/2];
+SensorHandle DynamicAdaptiveFilterV2::sensorHandle(const String& sensorId) const {
+  return _sensors.find(sensorId);
+}
 
-  delete[] temp;
-  return mad * 1.4826f;
+bool DynamicAdaptiveFilterV2::pushSensor(SensorHandle handle, const float* values, size_t count, unsigned long timestamp) {
+  const SensorRegistry::Route* route = _sensors.route(handle);
+  if (route == nullptr || count > route->channelCount) {
+    return false;
+  }
+  return pushSamples(values, count, timestamp, route->firstChannel);
 }
 
-bool DynamicAdaptiveFilterV2::pushSensorData(const SensorData& data) {
-  if (data.values.empty() || data.values.size() > _filters.size()) {
+bool DynamicAdaptiveFilterV2::pushSamples(const float* values, size_t count, unsigned long timestamp, size_t firstChannel) {
+  if (values == nullptr || count == 0 || firstChannel >= _filters.size() || count > _filters.size() - firstChannel) {
     return false;
   }
 
+  unsigned long currentTime = timestamp == 0 ? millis() : timestamp;
   bool success = true;
-  for (size_t i = 0; i < data.values.size(); ++i) {
-    FilterState& state = _filters[i];
-    const FilterConfig& config = _configs[i];
-    unsigned long currentTime = data.timestamp == 0 ? millis() : data.timestamp;
-    unsigned long deltaT = currentTime > state.lastPushTime ? currentTime - state.lastPushTime : 0;
-    if (deltaT < state.expectedIntervalMs / 2) {
-      continue; // Zu schnelle Daten ignorieren
+  for (size_t i = 0; i < count; ++i) {
+    if (processSample(firstChannel + i, values[i], currentTime) == SAMPLE_OUTLIER) {
+      success = false;
     }
-    state.lastPushTime = currentTime;
+  }
+  return success;
+}
 
-    float decayFactor = calculateDecayFactor(state, deltaT);
-    float value = data.values[i];
+DynamicAdaptiveFilterV2::SampleResult DynamicAdaptiveFilterV2::processSample(size_t channel, float value, unsigned long currentTime) {
+#if defined(DAF_ENABLE_STATS)
+  uint32_t start = statsCycles();
+  SampleResult result = filterSample(channel, value, currentTime);
+  _filters[channel].stats.record(statsReason(result), statsCycles() - start);
+  return result;
+#else
+  return filterSample(channel, value, currentTime);
+#endif
+}
 
-    if (state.mode == VALUE_MODE && !isSignificantChange(state, value)) {
-      continue;
+DynamicAdaptiveFilterV2::SampleResult DynamicAdaptiveFilterV2::filterSample(size_t channel, float value, unsigned long currentTime) {
+  FilterState& state = _filters[channel];
+  const FilterConfig& config = _configs[channel];
+  unsigned long deltaT = pushDeltaT(currentTime, state.lastPushTime, state.pushed);
+  if (config.type == DECIMATE && state.mode == VALUE_MODE) {
+    return decimateSample(channel, value, currentTime, deltaT);
+  }
+  if (deltaT < state.expectedIntervalMs / 2) {
+    return SAMPLE_RATE_LIMITED; // Zu schnelle Daten ignorieren
+  }
+  state.lastPushTime = currentTime;
+  state.pushed = true;
+
+  Decay decayFactor = calculateDecayFactor(state, deltaT);
+
+  if (state.mode == VALUE_MODE && state.madWindow.enabled()) {
+    state.madWindow.push(value);
+    if (isOutlier(state, config, value)) {
+      return SAMPLE_OUTLIER;
     }
+  }
 
-    if (state.mode == COUNT_MODE) {
-      if (micros() - state.lastPushTime * 1000UL < state.deadTimeUs) {
-        continue;
-      }
-      state.pulseCount++;
-      continue;
+  if (state.mode == VALUE_MODE && !isSignificantChange(state, value)) {
+    return SAMPLE_BELOW_THRESHOLD;
+  }
+
+  if (state.mode == COUNT_MODE) {
+    if (micros() - state.lastPushTime * 1000UL < state.deadTimeUs) {
+      return SAMPLE_DEAD_TIME;
     }
+    countPulses(state, 1, currentTime);
+    return SAMPLE_COUNTED;
+  }
+
+#if defined(DAF_FIXED_POINT)
+  if (state.fixedScale == 0.0f) initFixedScale(state, config, value);
+#endif
+  applyFilter(state, config, value, decayFactor);
+  _outputs[channel] = state.filteredValue;
+  return SAMPLE_FILTERED;
+}
 
-    if (config.type == EMA) {
-      updateEMA(state, value, decayFactor);
-    } else if (config.type == SMA || config.type == FIR) {
-      pushToHistory(state, value);
-      updateSMAorFIR(state, decayFactor);
+// DECIMATE: Jedes Sample geht in den Dezimator, ohne Raten-Gate und Schmitt-Trigger
+// (normalFreqHz ist die Abtastrate des Eingangs). Ausreißer werden durch den Median
+// ersetzt statt verworfen, damit der Abtasttakt gleichmäßig bleibt. Nach einer
+// Lücke ab maxDecayTimeMs beginnt der Dezimator eingeschwungen mit dem neuen Wert.
+DynamicAdaptiveFilterV2::SampleResult DynamicAdaptiveFilterV2::decimateSample(size_t channel, float value, unsigned long currentTime,
+                                                                               unsigned long deltaT) {
+  FilterState& state = _filters[channel];
+  const FilterConfig& config = _configs[channel];
+  SampleResult result = SAMPLE_FILTERED;
+  if (state.madWindow.enabled()) {
+    state.madWindow.push(value);
+    if (isOutlier(state, config, value)) {
+      value = state.madWindow.median();
+      result = SAMPLE_OUTLIER;
     }
+  }
+  if (!state.decimator.primed() || deltaT >= state.maxDecayTimeMs) {
+    state.decimator.prime(value);
+    state.filteredValue = value;
+  }
+  state.lastPushTime = currentTime;
+  state.pushed = true;
+  float output;
+  if (state.decimator.push(value, output)) {
+    state.filteredValue = output;
+  }
+  _outputs[channel] = state.filteredValue;
+  return result;
+}
+
+void DynamicAdaptiveFilterV2::applyFilter(FilterState& state, const FilterConfig& config, float value, Decay decayFactor) {
+  if (config.type == EMA) {
+    updateEMA(state, value, decayFactor);
+  } else if (config.type == SMA) {
+    updateSMA(state, value, decayFactor);
+  } else if (config.type == FIR) {
+    pushToHistory(state, value);
+    updateFIR(state, decayFactor);
+  } else if (config.type == BIQUAD) {
+    updateBiquad(state, value, decayFactor);
+  }
 #if defined(USE_KALMAN)
-    else if (config.type == KALMAN) {
-      float K = state.P * (1.0f / (state.P + config.R));
-      state.x = state.x + K * (value - state.x);
-      state.P = (1.0f - K) * state.P + config.Q;
-      state.filteredValue = state.x;
-    }
+  else if (config.type == KALMAN) {
+    updateKalman(state, config, value);
+  }
 #endif
 #if defined(USE_LMS)
-    else if (config.type == LMS) {
-      state.inputBuffer[state.bufferIndex] = value;
-      float mad = calculateMAD(state.inputBuffer, config.length);
-      float median = state.inputBuffer[config.length/2];
-      if (abs(value - median) > config.madThreshold * mad) {
-        success = false;
-        continue;
-      }
+  else if (config.type == LMS) {
+    updateLMS(state, config, value);
+  }
+#endif
+#if defined(USE_RLS)
+  else if (config.type == RLS) {
+    updateRLS(state, config, value);
+  }
+#endif
+}
+
+DynamicAdaptiveFilterV2::BlockResult DynamicAdaptiveFilterV2::pushBlock(int channel, const float* values, const uint32_t* timestamps, size_t n) {
+  BlockResult result = {0, 0};
+  if (channel < 0 || channel >= (int)_filters.size() || values == nullptr || n == 0) {
+    return result;
+  }
 
-      float dynamicMu = config.mu / (mad + 1e-6f);
-      dynamicMu = constrain(dynamicMu, 0.001f, 0.1f);
+  FilterState& state = _filters[channel];
+  const FilterConfig& config = _configs[channel];
 
-      float output = 0.0f;
-      for (int j = 0; j < config.length; j++) {
-        int idx = (state.bufferIndex - j - 1 + config.length) % config.length;
-        output += state.coeffs[j] * state.inputBuffer[idx];
-      }
-      float error = value - output;
-      for (int j = 0; j < config.length; j++) {
-        int idx = (state.bufferIndex - j - 1 + config.length) % config.length;
-        state.coeffs[j] += dynamicMu * error * state.inputBuffer[idx];
-      }
-      state.filteredValue = output;
-      state.inputBuffer[state.bufferIndex] = value;
-      state.bufferIndex = (state.bufferIndex + 1) % config.length;
+  // Typ-Dispatch einmal pro Block, danach eine enge Schleife je Filtertyp
+  if (state.mode == COUNT_MODE || config.type == DECIMATE) {
+    unsigned long now = millis();
+    for (size_t i = 0; i < n; ++i) {
+      SampleResult r = processSample(channel, values[i], blockTimestamp(state, timestamps, i, n, now));
+      if (r == SAMPLE_COUNTED || r == SAMPLE_FILTERED) result.accepted++; else result.rejected++;
     }
+    return result;
+  }
+
+  if (config.type == EMA) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay decayFactor) { updateEMA(state, value, decayFactor); });
+  } else if (config.type == SMA) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay decayFactor) { updateSMA(state, value, decayFactor); });
+  } else if (config.type == FIR) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay decayFactor) { pushToHistory(state, value); updateFIR(state, decayFactor); });
+  } else if (config.type == BIQUAD) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay decayFactor) { updateBiquad(state, value, decayFactor); });
+  }
+#if defined(USE_KALMAN)
+  else if (config.type == KALMAN) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay) { updateKalman(state, config, value); });
+  }
+#endif
+#if defined(USE_LMS)
+  else if (config.type == LMS) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay) { updateLMS(state, config, value); });
+  }
 #endif
 #if defined(USE_RLS)
-    else if (config.type == RLS) {
-      state.inputBuffer[state.bufferIndex] = value;
-      state.bufferIndex = (state.bufferIndex + 1) % config.length;
-      state.filteredValue = value;
+  else if (config.type == RLS) {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay) { updateRLS(state, config, value); });
+  }
+#endif
+  else {
+    result = runBlock(state, config, values, timestamps, n,
+                      [&](float value, Decay decayFactor) { applyFilter(state, config, value, decayFactor); });
+  }
+  _outputs[channel] = state.filteredValue;
+  return result;
+}
+
+// Gate-Logik von processSample() für VALUE_MODE, mit Zeitbasis und Grenzen in lokalen Variablen
+template <typename Update>
+DynamicAdaptiveFilterV2::BlockResult DynamicAdaptiveFilterV2::runBlock(FilterState& state, const FilterConfig& config, const float* values,
+                                                                     const uint32_t* timestamps, size_t n, Update update) {
+  BlockResult result = {0, 0};
+#if defined(DAF_ENABLE_STATS)
+  uint32_t start = statsCycles();
+  uint32_t reasons[STATS_REASON_COUNT] = {0};
+#endif
+  auto reject = [&](StatsReason reason) {
+    result.rejected++;
+#if defined(DAF_ENABLE_STATS)
+    reasons[reason]++;
+#else
+    (void)reason;
+#endif
+  };
+  unsigned long now = timestamps == nullptr ? millis() : 0;
+  unsigned long minDeltaT = state.expectedIntervalMs / 2;
+  unsigned long lastPushTime = state.lastPushTime;
+  bool pushed = state.pushed;
+  bool useMad = state.madWindow.enabled();
+
+  for (size_t i = 0; i < n; ++i) {
+    unsigned long currentTime = blockTimestamp(state, timestamps, i, n, now);
+    unsigned long deltaT = pushDeltaT(currentTime, lastPushTime, pushed);
+    if (deltaT < minDeltaT) {
+      reject(STATS_RATE_LIMITED);
+      continue;
+    }
+    lastPushTime = currentTime;
+    pushed = true;
+
+    float value = values[i];
+    if (useMad) {
+      state.madWindow.push(value);
+      if (isOutlier(state, config, value)) {
+        reject(STATS_OUTLIER);
+        continue;
+      }
     }
+    if (!isSignificantChange(state, value)) {
+      reject(STATS_BELOW_THRESHOLD);
+      continue;
+    }
+#if defined(DAF_FIXED_POINT)
+    if (state.fixedScale == 0.0f) initFixedScale(state, config, value);
 #endif
+    update(value, calculateDecayFactor(state, deltaT));
+    result.accepted++;
   }
-  return success;
+  state.lastPushTime = lastPushTime;
+  state.pushed = pushed;
+#if defined(DAF_ENABLE_STATS)
+  reasons[STATS_ACCEPTED] = static_cast<uint32_t>(result.accepted);
+  state.stats.recordBlock(reasons, statsCycles() - start);
+#endif
+  return result;
+}
+
+unsigned long DynamicAdaptiveFilterV2::blockTimestamp(const FilterState& state, const uint32_t* timestamps, size_t i, size_t n, unsigned long now) const {
+  if (timestamps != nullptr) return timestamps[i];
+  unsigned long offset = (n - 1 - i) * state.expectedIntervalMs;
+  return offset < now ? now - offset : 0;
 }
 
 std::vector<float> DynamicAdaptiveFilterV2::getFilteredValues() const {
-  std::vector<float> result(_filters.size());
-  for (size_t i = 0; i < _filters.size(); ++i) {
-    result[i] = _filters[i].filteredValue;
+  return _outputs;
+}
+
+float DynamicAdaptiveFilterV2::getFilteredValue(int channel) const {
+  if (channel < 0 || channel >= (int)_outputs.size()) return 0.0f;
+  return _outputs[channel];
+}
+
+size_t DynamicAdaptiveFilterV2::copyFilteredValues(float* dst, size_t n) const {
+  if (dst == nullptr) return 0;
+  size_t count = min(n, _outputs.size());
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = _outputs[i];
   }
-  return result;
+  return count;
 }
 
 void DynamicAdaptiveFilterV2::updateNormalFreq(int channel, float normalFreqHz) {
@@ -227,8 +409,13 @@ void DynamicAdaptiveFilterV2::updateNormalFreq(int channel, float normalFreqHz)
 
 void DynamicAdaptiveFilterV2::updateLength(int channel, int length) {
   if (channel >= (int)_filters.size()) return;
-  if (_filters[channel].type == EMA || _filters[channel].type == SMA) {
+  if (_filters[channel].type == EMA) {
+#if defined(DAF_FIXED_POINT)
+    _filters[channel].baseAlpha = floatToQ31(2.0f / (max(1, length) + 1.0f));
+#else
     _filters[channel].baseAlpha = 2.0f / (max(1, length) + 1.0f);
+#endif
+  } else if (_filters[channel].type == SMA) {
     initSMA(_filters[channel], max(1, length));
   }
 }
@@ -238,6 +425,18 @@ void DynamicAdaptiveFilterV2::updateFIRCoeffs(int channel, const float* coeffs,
   initFIR(_filters[channel], coeffs, numCoeffs);
 }
 
+#if defined(DAF_FIXED_POINT)
+void DynamicAdaptiveFilterV2::updateFIRCoeffs(int channel, const q15_t* coeffs, int numCoeffs) {
+  if (channel >= (int)_filters.size() || _filters[channel].type != FIR) return;
+  initFIR(_filters[channel], coeffs, numCoeffs);
+}
+#endif
+
+void DynamicAdaptiveFilterV2::updateBiquadCoeffs(int channel, const float* coeffs, int numCoeffs) {
+  if (channel >= (int)_filters.size() || _filters[channel].type != BIQUAD || !biquadValid(coeffs, numCoeffs)) return;
+  initBiquad(_filters[channel], coeffs, numCoeffs);
+}
+
 void DynamicAdaptiveFilterV2::updateMaxDecayTime(int channel, unsigned long maxDecayTimeMs) {
   if (channel >= (int)_filters.size()) return;
   _filters[channel].maxDecayTimeMs = max(1000UL, maxDecayTimeMs);
@@ -256,81 +455,469 @@ void DynamicAdaptiveFilterV2::updateDeadTime(int channel, float deadTimeUs) {
 void DynamicAdaptiveFilterV2::updateMode(int channel, FilterMode mode) {
   if (channel >= (int)_filters.size()) return;
   _filters[channel].mode = mode;
-  if (mode == COUNT_MODE) _filters[channel].warmUpTimeMs = max(_filters[channel].warmUpTimeMs, 60000UL);
+  if (mode == COUNT_MODE) {
+    _filters[channel].warmUpTimeMs = max(_filters[channel].warmUpTimeMs, 60000UL);
+    if (!_filters[channel].pulseWindow.enabled()) _filters[channel].pulseWindow.reset(CPM_WINDOW_BUCKETS, millis());
+  }
 }
 
 void DynamicAdaptiveFilterV2::onPulse(int channel) {
   if (channel >= (int)_filters.size()) return;
-  _filters[channel].pulseCount++;
+  countPulses(_filters[channel], 1, millis());
+}
+
+void DynamicAdaptiveFilterV2::onPulses(int channel, unsigned long count) {
+  if (channel >= (int)_filters.size()) return;
+  countPulses(_filters[channel], count, millis());
+}
+
+void DynamicAdaptiveFilterV2::countPulses(FilterState& state, unsigned long count, unsigned long now) {
+  state.pulseCount += count;
+  state.pulseWindow.add(static_cast<uint32_t>(count), now);
 }
 
 unsigned long DynamicAdaptiveFilterV2::getCPM(int channel) {
   if (channel >= (int)_filters.size()) return 0;
-  unsigned long deltaT = millis() - _filters[channel].startTime;
-  return _filters[channel].pulseCount * 60000UL / max(1UL, deltaT);
+  return getCPM(channel, _filters[channel].cpmWindowMs);
 }
 
-float DynamicAdaptiveFilterV2::calculateDecayFactor(const FilterState& state, unsigned long deltaT) const {
-  if (deltaT <= state.expectedIntervalMs) {
-    return 1.0f;
-  } else if (deltaT >= state.maxDecayTimeMs) {
-    return 0.0f;
-  } else {
-    return 1.0f - static_cast<float>(deltaT - state.expectedIntervalMs) / static_cast<float>(state.maxDecayTimeMs - state.expectedIntervalMs);
+unsigned long DynamicAdaptiveFilterV2::getCPM(int channel, unsigned long windowMs) {
+  if (channel >= (int)_filters.size()) return 0;
+  FilterState& state = _filters[channel];
+  unsigned long now = millis();
+  PulseSpan span = windowMs == 0 ? state.pulseWindow.adaptive(now) : state.pulseWindow.window(windowMs, now);
+  if (span.counts == 0) return 0;
+  float measured = span.counts * 1000.0f / span.spanMs; // Pulse/s
+  return static_cast<unsigned long>(deadTimeCorrectedRate(measured, state.deadTimeUs * 1e-6f) * 60.0f + 0.5f);
+}
+
+void DynamicAdaptiveFilterV2::updateCPMWindow(int channel, unsigned long windowMs) {
+  if (channel >= (int)_filters.size()) return;
+  _filters[channel].cpmWindowMs = windowMs;
+}
+
+unsigned long DynamicAdaptiveFilterV2::getPulseCount(int channel) const {
+  if (channel < 0 || channel >= (int)_filters.size()) return 0;
+  return _filters[channel].pulseCount;
+}
+
+DynamicAdaptiveFilterV2::Decay DynamicAdaptiveFilterV2::calculateDecayFactor(const FilterState& state, unsigned long deltaT) const {
+#if defined(DAF_FIXED_POINT)
+  return fixedDecayFactor(deltaT, state.expectedIntervalMs, state.maxDecayTimeMs);
+#else
+  return filterDecayFactor(deltaT, state.expectedIntervalMs, state.maxDecayTimeMs);
+#endif
+}
+
+#if defined(DAF_FIXED_POINT)
+// Vollausschlag aus fullScale oder aus dem ersten gefilterten Sample, siehe filterFullScale()
+void DynamicAdaptiveFilterV2::initFixedScale(FilterState& state, const FilterConfig& config, float value) {
+  float scale = filterFullScale(config.fullScale, value);
+  state.fixedScale = scale;
+  state.fixedInvScale = 1.0f / scale;
+#if defined(USE_KALMAN)
+  if (state.type == KALMAN) {
+    state.x = toFixed(state, config.initialState);
   }
+#endif
 }
 
-void DynamicAdaptiveFilterV2::updateEMA(FilterState& state, float value, float decayFactor) {
-  float effectiveAlpha = 1.0f - decayFactor * (1.0f - state.baseAlpha);
-  state.filteredValue = effectiveAlpha * value + (1.0f - effectiveAlpha) * state.filteredValue;
+q31_t DynamicAdaptiveFilterV2::toFixed(const FilterState& state, float value) const {
+  return floatToQ31(value * state.fixedInvScale);
 }
 
-void DynamicAdaptiveFilterV2::updateSMAorFIR(FilterState& state, float decayFactor) {
-  int num = state.baseCoeffs.size();
-  int histSize = state.history.size();
-  state.filteredValue = 0.0f;
-  float sumScaled = 0.0f;
-  if (histSize > 0) {
-    state.filteredValue += state.baseCoeffs[0] * state.history.back();
-    sumScaled += state.baseCoeffs[0];
+void DynamicAdaptiveFilterV2::setFixedOutput(FilterState& state, q31_t value) {
+  state.fixedValue = value;
+  state.filteredValue = q31ToFloat(value) * state.fixedScale;
+}
+#endif
+
+void DynamicAdaptiveFilterV2::updateEMA(FilterState& state, float value, Decay decayFactor) {
+#if defined(DAF_FIXED_POINT)
+  setFixedOutput(state, emaStepQ31(state.fixedValue, toFixed(state, value), state.baseAlpha, decayFactor));
+#else
+  state.filteredValue = emaStep(state.filteredValue, value, state.baseAlpha, decayFactor);
+#endif
+}
+
+#if defined(USE_KALMAN)
+void DynamicAdaptiveFilterV2::updateKalman(FilterState& state, const FilterConfig& config, float value) {
+#if defined(DAF_FIXED_POINT)
+  (void)config; // Q/R stecken normiert in state.Q und state.P
+  setFixedOutput(state, kalmanStepQ31(state.x, state.P, state.Q, toFixed(state, value)));
+#else
+  state.filteredValue = kalmanStep(state.x, state.P, config.Q, config.R, value);
+#endif
+}
+#endif
+
+#if defined(USE_LMS)
+void DynamicAdaptiveFilterV2::updateLMS(FilterState& state, const FilterConfig& config, float value) {
+  // Eingangspuffer liegt zusammenhängend, neuester Wert zuerst (passend zu coeffs[0])
+#if defined(DAF_FIXED_POINT)
+  // Schrittweite im Q31-Wertebereich: mu * e * x = mu * fullScale^2 * e_q * x_q
+  float stepSize = lmsStepSize(config.mu, state.madWindow.mad()) * state.fixedScale * state.fixedScale;
+  q31_t sample = toFixed(state, value);
+  setFixedOutput(state, lmsStepQ31(state.coeffs, state.inputBuffer + state.bufferIndex, config.length, floatToQ16(stepSize), sample));
+  mirroredRingPush(state.inputBuffer, state.bufferIndex, config.length, sample);
+#else
+  const float* input = state.inputBuffer + state.bufferIndex;
+  state.filteredValue = lmsStep(state.coeffs, input, config.length, config.mu, state.madWindow.mad(), value);
+  pushToInputBuffer(state, config.length, value);
+#endif
+}
+#endif
+
+#if defined(USE_RLS)
+void DynamicAdaptiveFilterV2::updateRLS(FilterState& state, const FilterConfig& config, float value) {
+  // Prädiktion aus den letzten length Werten wie updateLMS(), Gewichte per RLS
+  float gain[MAX_FILTER_LENGTH];
+  const float* input = state.inputBuffer + state.bufferIndex;
+  state.filteredValue = rlsStep(state.coeffs, state.P, gain, input, config.length, config.lambda, value);
+  pushToInputBuffer(state, config.length, value);
+}
+#endif
+
+#if defined(USE_LMS) || defined(USE_RLS)
+void DynamicAdaptiveFilterV2::pushToInputBuffer(FilterState& state, int length, float value) {
+#if defined(DAF_FIXED_POINT) && defined(USE_LMS)
+  mirroredRingPush(state.inputBuffer, state.bufferIndex, length, toFixed(state, value));
+#else
+  mirroredRingPush(state.inputBuffer, state.bufferIndex, length, value);
+#endif
+}
+#endif
+
+// SMA in O(1): laufende Summe statt Skalarprodukt mit 1/length-Koeffizienten.
+// Entspricht updateFIR() mit gleichverteilten Koeffizienten, inkl. decayFactor.
+void DynamicAdaptiveFilterV2::updateSMA(FilterState& state, float value, Decay decayFactor) {
+#if defined(DAF_FIXED_POINT)
+  // Ganzzahlige Summe ist exakt, Kahan und Neuberechnung entfallen
+  q31_t sample = toFixed(state, value);
+  if (state.history.full()) {
+    state.smaSum -= state.history.oldest();
   }
-  for (int i = 1; i < num; ++i) {
-    if (i >= histSize) break;
-    float pastCoeff = state.baseCoeffs[i] * decayFactor;
-    state.filteredValue += pastCoeff * state.history[histSize - 1 - i];
-    sumScaled += pastCoeff;
+  state.history.push(sample);
+  state.smaSum += sample;
+  setFixedOutput(state, smaDecayedOutputQ31(state.smaSum, sample, state.history.capacity(), state.history.size(), decayFactor));
+#else
+  if (state.history.full()) {
+    kahanAdd(state.smaSum, state.smaCompensation, -state.history.oldest());
   }
-  if (sumScaled < 1.0f && histSize > 0) {
-    state.filteredValue += (1.0f - sumScaled) * state.history.back();
+  state.history.push(value);
+  kahanAdd(state.smaSum, state.smaCompensation, value);
+  if (++state.smaPushCount >= SMA_RESYNC_INTERVAL) {
+    resyncSMASum(state);
   }
+
+  state.filteredValue = smaDecayedOutput(state.smaSum, value, state.history.capacity(), state.history.size(), decayFactor);
+#endif
+}
+
+#if !defined(DAF_FIXED_POINT)
+// Begrenzt die Float-Drift der laufenden Summe (amortisiert O(1) pro Sample)
+void DynamicAdaptiveFilterV2::resyncSMASum(FilterState& state) {
+  const float* hist = state.history.newestFirst();
+  state.smaSum = 0.0f;
+  state.smaCompensation = 0.0f;
+  for (size_t i = 0; i < state.history.size(); ++i) {
+    kahanAdd(state.smaSum, state.smaCompensation, hist[i]);
+  }
+  state.smaPushCount = 0;
+}
+#endif
+
+void DynamicAdaptiveFilterV2::updateFIR(FilterState& state, Decay decayFactor) {
+  // Fenster liegt zusammenhängend, neuester Wert zuerst (passend zu baseCoeffs[0])
+#if defined(DAF_FIXED_POINT)
+  setFixedOutput(state, firDecayedOutputQ31(state.baseCoeffs.data(), state.baseCoeffs.size(), state.firPastCoeffSum,
+                                            state.history.newestFirst(), state.history.size(), decayFactor, state.firSymmetric));
+#else
+  state.filteredValue = firDecayedOutput(state.baseCoeffs.data(), state.baseCoeffs.size(), state.firPastCoeffSum,
+                                         state.history.newestFirst(), state.history.size(), decayFactor, state.firSymmetric);
+#endif
+}
+
+// Startet eingeschwungen mit dem ersten Sample. decayFactor < 1 (Lücke) zieht den
+// Zustand anteilig zum eingeschwungenen Zustand des neuen Werts, bei 0 ganz (wie EMA).
+void DynamicAdaptiveFilterV2::updateBiquad(FilterState& state, float value, Decay decayFactor) {
+#if defined(DAF_FIXED_POINT)
+  float decay = state.biquadPrimed ? decayToFloat(decayFactor) : 0.0f;
+#else
+  float decay = state.biquadPrimed ? decayFactor : 0.0f;
+#endif
+  state.biquadPrimed = true;
+  state.filteredValue = biquadDecayedOutput(state.biquadCoeffs.data(), state.biquadState.data(),
+                                            static_cast<int>(state.biquadCoeffs.size()) / BIQUAD_SECTION_COEFFS,
+                                            state.biquadGain, state.biquadOffset, value, decay);
 }
 
 void DynamicAdaptiveFilterV2::initSMA(FilterState& state, int length) {
-  state.baseCoeffs.resize(length, 1.0f / length);
-  state.history.clear();
+  state.baseCoeffs.clear();
+  state.firSymmetric = false;
+  state.history.reset(length);
+#if defined(DAF_FIXED_POINT)
+  state.smaSum = 0;
+#else
+  state.smaSum = 0.0f;
+  state.smaCompensation = 0.0f;
+  state.smaPushCount = 0;
+#endif
 }
 
 void DynamicAdaptiveFilterV2::initFIR(FilterState& state, const float* coeffs, int numCoeffs) {
+#if defined(DAF_FIXED_POINT)
+  std::vector<q15_t> fixedCoeffs(numCoeffs);
+  for (int i = 0; i < numCoeffs; ++i) fixedCoeffs[i] = floatToQ15(coeffs[i]);
+  initFIR(state, fixedCoeffs.data(), numCoeffs);
+#else
+  state.baseCoeffs.assign(coeffs, coeffs + numCoeffs);
+  state.history.reset(numCoeffs);
+  state.firPastCoeffSum = 0.0f;
+  for (int i = 1; i < numCoeffs; ++i) state.firPastCoeffSum += coeffs[i];
+  state.firSymmetric = firIsSymmetric(coeffs, numCoeffs);
+#endif
+}
+
+#if defined(DAF_FIXED_POINT)
+void DynamicAdaptiveFilterV2::initFIR(FilterState& state, const q15_t* coeffs, int numCoeffs) {
   state.baseCoeffs.assign(coeffs, coeffs + numCoeffs);
-  state.history.clear();
+  state.history.reset(numCoeffs);
+  state.firPastCoeffSum = 0;
+  for (int i = 1; i < numCoeffs; ++i) state.firPastCoeffSum += coeffs[i];
+  state.firSymmetric = firIsSymmetric(coeffs, numCoeffs);
+}
+#endif
+
+void DynamicAdaptiveFilterV2::initBiquad(FilterState& state, const float* coeffs, int numCoeffs) {
+  state.biquadCoeffs.assign(coeffs, coeffs + numCoeffs);
+  state.biquadState.assign(numCoeffs / BIQUAD_SECTION_COEFFS * 2, 0.0f);
+  state.biquadOffset = 0.0f;
+  state.biquadGain = biquadGain(coeffs, numCoeffs / BIQUAD_SECTION_COEFFS);
+  state.biquadPrimed = false;
 }
 
 void DynamicAdaptiveFilterV2::pushToHistory(FilterState& state, float value) {
-  state.history.push_back(value);
-  if (state.history.size() > state.baseCoeffs.size()) {
-    state.history.erase(state.history.begin());
-  }
+#if defined(DAF_FIXED_POINT)
+  state.history.push(toFixed(state, value));
+#else
+  state.history.push(value);
+#endif
 }
 
 void DynamicAdaptiveFilterV2::initializeHistory(FilterState& state, float value) {
-  int num = state.baseCoeffs.size();
-  state.history.assign(num, value);
-  updateSMAorFIR(state, 1.0f);
+#if defined(DAF_FIXED_POINT)
+  q31_t sample = toFixed(state, value);
+  state.history.fill(sample);
+  if (state.type == SMA) {
+    state.smaSum = static_cast<int64_t>(sample) * static_cast<int64_t>(state.history.size());
+    setFixedOutput(state, sample);
+  } else {
+    updateFIR(state, Q31_ONE);
+  }
+#else
+  state.history.fill(value);
+  if (state.type == SMA) {
+    resyncSMASum(state);
+    state.filteredValue = value;
+  } else {
+    updateFIR(state, 1.0f);
+  }
+#endif
 }
 
 bool DynamicAdaptiveFilterV2::isSignificantChange(const FilterState& state, float value) const {
-  if (state.thresholdPercent == 0.0f) return true;
-  if (abs(state.filteredValue) < 1e-6) return true;
-  float change = abs(value - state.filteredValue) / abs(state.filteredValue);
-  return change * 100.0f >= state.thresholdPercent;
+  return filterSignificantChange(value, state.filteredValue, state.thresholdPercent);
+}
+
+bool DynamicAdaptiveFilterV2::isOutlier(const FilterState& state, const FilterConfig& config, float value) const {
+  return filterIsOutlier(state.madWindow, config.madThreshold, value);
+}
+
+#if defined(DAF_ENABLE_STATS)
+bool DynamicAdaptiveFilterV2::getStats(int channel, FilterStats& stats) const {
+  if (channel < 0 || channel >= (int)_filters.size()) return false;
+  return _filters[channel].stats.snapshot(stats);
+}
+
+void DynamicAdaptiveFilterV2::resetStats(int channel) {
+  if (channel < 0 || channel >= (int)_filters.size()) return;
+  _filters[channel].stats.reset();
+}
+
+StatsReason DynamicAdaptiveFilterV2::statsReason(SampleResult result) {
+  switch (result) {
+    case SAMPLE_RATE_LIMITED: return STATS_RATE_LIMITED;
+    case SAMPLE_BELOW_THRESHOLD: return STATS_BELOW_THRESHOLD;
+    case SAMPLE_OUTLIER: return STATS_OUTLIER;
+    case SAMPLE_DEAD_TIME: return STATS_DEAD_TIME;
+    default: return STATS_ACCEPTED;
+  }
+}
+#endif
+
+static uint16_t snapshotBuild() {
+  uint16_t build = 0;
+#if defined(USE_KALMAN)
+  build |= SNAPSHOT_BUILD_KALMAN;
+#endif
+#if defined(USE_LMS)
+  build |= SNAPSHOT_BUILD_LMS;
+#endif
+#if defined(USE_RLS)
+  build |= SNAPSHOT_BUILD_RLS;
+#endif
+#if defined(DAF_FIXED_POINT)
+  build |= SNAPSHOT_BUILD_FIXED;
+#endif
+  return build;
+}
+
+// Schreibt (SnapshotWriter, const State) oder liest (SnapshotReader) einen Kanal;
+// Reihenfolge der Felder = Format SNAPSHOT_VERSION
+template <typename Archive, typename State>
+void DynamicAdaptiveFilterV2::transferState(Archive& ar, State& state) {
+  ar.u32(state.type);
+  ar.u32(state.mode);
+  ar.io(state.normalFreqHz);
+  ar.u32(state.expectedIntervalMs);
+  ar.u32(state.maxDecayTimeMs);
+  ar.u32(state.warmUpTimeMs);
+  ar.io(state.thresholdPercent);
+  ar.io(state.deadTimeUs);
+  ar.time(state.startTime);
+  ar.time(state.lastPushTime);
+  ar.io(state.pushed);
+  ar.io(state.filteredValue);
+#if defined(DAF_FIXED_POINT)
+  ar.io(state.fixedScale);
+  ar.io(state.fixedInvScale);
+  ar.io(state.fixedValue);
+  ar.io(state.baseAlpha);
+  ar.object(state.history);
+  ar.vector(state.baseCoeffs);
+  ar.io(state.firPastCoeffSum);
+  ar.io(state.smaSum);
+#else
+  ar.io(state.baseAlpha);
+  ar.object(state.history);
+  ar.vector(state.baseCoeffs);
+  ar.io(state.firPastCoeffSum);
+  ar.io(state.smaSum);
+  ar.io(state.smaCompensation);
+  ar.u32(state.smaPushCount);
+#endif
+  ar.u32(state.pulseCount);
+  ar.u32(state.cpmWindowMs);
+  ar.object(state.pulseWindow);
+  ar.object(state.madWindow);
+  ar.object(state.decimator);
+  ar.vector(state.biquadCoeffs);
+  ar.vector(state.biquadState);
+  ar.io(state.biquadOffset);
+  ar.io(state.biquadGain);
+  ar.io(state.biquadPrimed);
+#if defined(USE_KALMAN)
+  ar.io(state.P);
+#if defined(DAF_FIXED_POINT)
+  ar.io(state.Q);
+#endif
+  ar.io(state.x);
+#endif
+#if defined(USE_LMS) || defined(USE_RLS)
+  ar.array(state.coeffs, MAX_FILTER_LENGTH);
+  ar.array(state.inputBuffer, 2 * MAX_FILTER_LENGTH);
+  ar.io(state.bufferIndex);
+#endif
+#if defined(USE_RLS)
+  ar.array(state.P, MAX_FILTER_LENGTH * MAX_FILTER_LENGTH);
+#endif
+}
+
+// Hash über Kanalzahl und alle Felder der FilterConfig (einzeln, ohne Padding)
+uint32_t DynamicAdaptiveFilterV2::configHash() const {
+  uint32_t count = static_cast<uint32_t>(_configs.size());
+  uint32_t hash = snapshotHash(&count, sizeof(count));
+  for (size_t i = 0; i < _configs.size(); ++i) {
+    const FilterConfig& c = _configs[i];
+    int32_t ints[] = {static_cast<int32_t>(c.type), c.length, c.numCoeffs, static_cast<int32_t>(c.maxDecayTimeMs),
+                      static_cast<int32_t>(c.warmUpTimeMs), static_cast<int32_t>(c.mode), c.decimation, c.cicStages, c.cicDecimation};
+    float floats[] = {c.normalFreqHz, c.thresholdPercent, c.deadTimeUs, c.madThreshold, c.fullScale};
+    hash = snapshotHash(ints, sizeof(ints), hash);
+    hash = snapshotHash(floats, sizeof(floats), hash);
+    if (c.coeffs != nullptr && c.numCoeffs > 0) hash = snapshotHash(c.coeffs, c.numCoeffs * sizeof(float), hash);
+#if defined(USE_KALMAN)
+    float kalman[] = {c.Q, c.R, c.initialState};
+    hash = snapshotHash(kalman, sizeof(kalman), hash);
+#endif
+#if defined(USE_LMS)
+    hash = snapshotHash(&c.mu, sizeof(c.mu), hash);
+#endif
+#if defined(USE_RLS)
+    hash = snapshotHash(&c.lambda, sizeof(c.lambda), hash);
+#endif
+  }
+  return hash;
+}
+
+size_t DynamicAdaptiveFilterV2::snapshotSize() const {
+  SnapshotWriter out(nullptr, 0, 0);
+  for (size_t i = 0; i < _filters.size(); ++i) {
+    transferState(out, _filters[i]);
+    out.io(_outputs[i]);
+  }
+  return sizeof(SnapshotHeader) + out.size();
+}
+
+size_t DynamicAdaptiveFilterV2::saveSnapshot(uint8_t* dst, size_t capacity) const {
+  if (dst == nullptr || capacity < sizeof(SnapshotHeader)) return 0;
+  uint8_t* payload = dst + sizeof(SnapshotHeader);
+  SnapshotWriter out(payload, capacity - sizeof(SnapshotHeader), millis());
+  for (size_t i = 0; i < _filters.size(); ++i) {
+    transferState(out, _filters[i]);
+    out.io(_outputs[i]);
+  }
+  if (!out.ok()) return 0;
+
+  SnapshotHeader header;
+  header.magic = SNAPSHOT_MAGIC;
+  header.version = SNAPSHOT_VERSION;
+  header.build = snapshotBuild();
+  header.channels = static_cast<uint32_t>(_filters.size());
+  header.configHash = configHash();
+  header.payloadSize = static_cast<uint32_t>(out.size());
+  header.crc = snapshotCrc32(payload, out.size());
+  memcpy(dst, &header, sizeof(header));
+  return sizeof(header) + out.size();
+}
+
+bool DynamicAdaptiveFilterV2::restoreSnapshot(const uint8_t* src, size_t size, unsigned long elapsedMs) {
+  if (src == nullptr || size < sizeof(SnapshotHeader)) return false;
+  SnapshotHeader header;
+  memcpy(&header, src, sizeof(header));
+  if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.build != snapshotBuild() ||
+      header.channels != _filters.size() || header.configHash != configHash() ||
+      header.payloadSize > size - sizeof(SnapshotHeader)) {
+    return false;
+  }
+  const uint8_t* payload = src + sizeof(SnapshotHeader);
+  if (snapshotCrc32(payload, header.payloadSize) != header.crc) return false;
+
+  SnapshotReader in(payload, header.payloadSize, millis(), elapsedMs);
+  bool valid = true;
+  for (size_t i = 0; i < _filters.size() && valid; ++i) {
+    transferState(in, _filters[i]);
+    in.io(_outputs[i]);
+    _filters[i].firSymmetric = firIsSymmetric(_filters[i].baseCoeffs.data(), _filters[i].baseCoeffs.size());
+    valid = in.ok() && _filters[i].type == _configs[i].type &&
+            _filters[i].biquadState.size() * BIQUAD_SECTION_COEFFS == _filters[i].biquadCoeffs.size() * 2;
+  }
+  if (valid && in.remaining() == 0) return true;
+
+  // Passt trotz gültiger Prüfsumme nicht (z. B. anderes MAX_FILTER_LENGTH): zurück auf begin()
+  for (size_t i = 0; i < _filters.size(); ++i) {
+    initFilter(_filters[i], _configs[i]);
+    _outputs[i] = _filters[i].filteredValue;
+  }
+  return false;
 }
@@ -2,10 +2,40 @@
 #define DYNAMIC_ADAPTIVE_FILTER_V2_H
 
 #include <Arduino.h>
+#include <array>
 #include <vector>
 #include <string>
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
+#include "filter/HistoryRing.h"
+#include "filter/StreamingMAD.h"
+#include "filter/DspKernels.h"
+#include "filter/FilterMath.h"
+#include "filter/SensorRegistry.h"
+#include "filter/PulseWindow.h"
+#include "filter/ChannelStats.h"
+#include "filter/Snapshot.h"
+#include "filter/TableRef.h"
+#include "filter/Decimator.h"
+#if defined(DAF_FIXED_POINT)
+#include "filter/FixedPoint.h"
+#endif
+
+// constexpr mit mehreren Anweisungen braucht C++14. Unter C++11 (z. B.
+// arduino-esp32 2.x mit -std=gnu++11) sind diese Funktionen nur inline und
+// DAF_VALIDATE_CONFIGS prüft nichts; begin() prüft zur Laufzeit wie bisher.
+#if __cplusplus >= 201402L
+#define DAF_CONSTEXPR14 constexpr
+#else
+#define DAF_CONSTEXPR14 inline
+#endif
 
 #define MAX_FILTER_LENGTH 5 // Maximale Filterlänge für LMS/RLS
+#define SMA_RESYNC_INTERVAL 1024 // SMA: Laufende Summe alle n Samples neu berechnen
+#define MAD_WINDOW_LENGTH 9 // Fensterlänge der Hampel/MAD-Vorstufe
 
 // Makro-Logik: Verhindere Kombinationen von Kalman, LMS und RLS
 #if defined(USE_KALMAN) && defined(USE_LMS)
@@ -32,6 +62,8 @@ enum FilterType {
 #if defined(USE_RLS)
   RLS,
 #endif
+  DECIMATE, // Dezimierender Tiefpass (Polyphasen-FIR, optional CIC) für schnelle ADC-Kanäle
+  BIQUAD,   // IIR-Kaskade aus Sektionen zweiter Ordnung, Entwurf per filter/BiquadDesign.h
 };
 
 // Filtermodi
@@ -44,15 +76,15 @@ enum FilterMode {
 struct FilterConfig {
   FilterType type;
   int length;                   // Für EMA/SMA: Fensterlänge; FIR: Ignoriert
-  const float* coeffs;          // Für FIR: Koeffizienten
-  int numCoeffs;                // Für FIR: Anzahl Koeffizienten
+  const float* coeffs;          // Für FIR/DECIMATE: Koeffizienten; BIQUAD: je Sektion b0, b1, b2, a1, a2
+  int numCoeffs;                // Für FIR/DECIMATE/BIQUAD: Anzahl Koeffizienten (BIQUAD: 5 je Sektion)
   float normalFreqHz;           // Normale Frequenz (Hz)
   unsigned long maxDecayTimeMs; // Max. Decay-Zeit (ms)
   unsigned long warmUpTimeMs;   // Warm-up-Zeit (ms)
   float thresholdPercent;       // Schmitt-Trigger-Threshold (%)
   float deadTimeUs;             // Dead Time (µs, für COUNT_MODE)
   FilterMode mode;              // VALUE_MODE oder COUNT_MODE
-  float madThreshold;           // Schwellwert für MAD (z.B. 3.0)
+  float madThreshold;           // Schwellwert für MAD-Ausreißerfilter (z.B. 3.0, 0 = aus)
 #if defined(USE_KALMAN)
   float Q;                      // Prozessrauschen
   float R;                      // Messrauschen
@@ -64,8 +96,23 @@ struct FilterConfig {
 #if defined(USE_RLS)
   float lambda;                 // Forget-Factor
 #endif
+  // Ab hier nicht von den USE_*-Feldern abhängig; in Tabellen per decimatedConfig() setzen
+  float fullScale;              // Vollausschlag für Q31 (DAF_FIXED_POINT) und den CIC-Eingang (0 = aus dem ersten Sample)
+  int decimation;               // DECIMATE: Dezimationsfaktor des FIR (coeffs/numCoeffs, Rate nach dem CIC)
+  int cicStages;                // DECIMATE: CIC-Stufen vor dem FIR (0 = ohne)
+  int cicDecimation;            // DECIMATE: Dezimationsfaktor der CIC-Stufe
 };
 
+// Kopie von config mit den DECIMATE-Feldern, für constexpr-Tabellen:
+//   decimatedConfig({DECIMATE, 0, lp.data(), lp.size(), 1000.0f, ...}, 10, 3, 10)
+// Eingang normalFreqHz, Ausgang normalFreqHz / (cicDecimation * decimation).
+DAF_CONSTEXPR14 FilterConfig decimatedConfig(FilterConfig config, int decimation, int cicStages = 0, int cicDecimation = 1) {
+  config.decimation = decimation;
+  config.cicStages = cicStages;
+  config.cicDecimation = cicDecimation;
+  return config;
+}
+
 // Sensor-Datenstruktur
 struct SensorData {
   std::vector<float> values;     // Messwerte (z.B. [Temp, Feuchte, Druck])
@@ -76,21 +123,111 @@ struct SensorData {
 
 class DynamicAdaptiveFilterV2 {
 public:
-  DynamicAdaptiveFilterV2(const std::vector<FilterConfig>& configs);
+  DynamicAdaptiveFilterV2(const std::vector<FilterConfig>& configs); // Legt eine Kopie an
+  // Ohne Kopie: die Tabelle muss den Filter überleben (constexpr-Tabellen aus params/, statische Arrays)
+  DynamicAdaptiveFilterV2(const FilterConfig* configs, size_t count);
+  template <size_t N>
+  DynamicAdaptiveFilterV2(const std::array<FilterConfig, N>& configs) : DynamicAdaptiveFilterV2(configs.data(), N) {}
+  template <size_t N>
+  DynamicAdaptiveFilterV2(const std::array<FilterConfig, N>&&) = delete; // Temporäre Tabelle würde ungültig
   void begin();
+  // Registrierte sensorId -> deren Kanalbereich, sonst values[i] an Kanal i
   bool pushSensorData(const SensorData& data);
+  // Sensor einmalig (setup) an die Kanäle firstChannel .. firstChannel + channelCount - 1 binden.
+  // INVALID_SENSOR_HANDLE bei ungültigem oder überlappendem Bereich.
+  SensorHandle registerSensor(const String& sensorId, size_t firstChannel, size_t channelCount);
+  SensorHandle sensorHandle(const String& sensorId) const;
+  // values[i] geht an den i-ten Kanal des Sensors, ohne String-Vergleich.
+  // false bei ungültigem Handle, count > Kanalzahl des Sensors oder verworfenem Ausreißer.
+  bool pushSensor(SensorHandle handle, const float* values, size_t count, unsigned long timestamp = 0);
+  template <size_t N>
+  bool pushSensor(SensorHandle handle, const std::array<float, N>& values, unsigned long timestamp = 0) {
+    return pushSensor(handle, values.data(), N, timestamp);
+  }
+  // Allokationsfreier Push: values[i] geht an Kanal firstChannel + i.
+  // timestamp == 0 -> millis(). false bei ungültigem Bereich oder verworfenem Ausreißer.
+  bool pushSamples(const float* values, size_t count, unsigned long timestamp = 0, size_t firstChannel = 0);
+  template <size_t N>
+  bool pushSamples(const std::array<float, N>& values, unsigned long timestamp = 0, size_t firstChannel = 0) {
+    return pushSamples(values.data(), N, timestamp, firstChannel);
+  }
+#if defined(__cpp_lib_span)
+  bool pushSamples(std::span<const float> values, unsigned long timestamp = 0, size_t firstChannel = 0) {
+    return pushSamples(values.data(), values.size(), timestamp, firstChannel);
+  }
+#endif
+  // Ergebnis von pushBlock(): übernommene bzw. verworfene Samples
+  struct BlockResult {
+    size_t accepted;
+    size_t rejected;
+  };
+  // Block mehrerer Samples eines Kanals (z. B. DMA-Puffer, GPS-Burst) in einer Schleife.
+  // timestamps == nullptr -> Samples im Abstand expectedIntervalMs, letztes Sample = millis().
+  BlockResult pushBlock(int channel, const float* values, const uint32_t* timestamps, size_t n);
+
   std::vector<float> getFilteredValues() const;
+  // Lesezugriff ohne Allokation
+  float getFilteredValue(int channel) const;
+  size_t copyFilteredValues(float* dst, size_t n) const;
+  const float* filteredValues() const { return _outputs.data(); } // channelCount() Werte, zusammenhängend
+  size_t channelCount() const { return _outputs.size(); }
   void updateNormalFreq(int channel, float normalFreqHz);
   void updateLength(int channel, int length);
   void updateFIRCoeffs(int channel, const float* coeffs, int numCoeffs);
+#if defined(DAF_FIXED_POINT)
+  void updateFIRCoeffs(int channel, const q15_t* coeffs, int numCoeffs); // z. B. aus FIR_coefficients_q15.h
+#endif
+  // Neue Kaskade gleicher oder anderer Sektionszahl; schwingt mit dem nächsten Sample neu ein
+  void updateBiquadCoeffs(int channel, const float* coeffs, int numCoeffs);
   void updateMaxDecayTime(int channel, unsigned long maxDecayTimeMs);
   void updateThreshold(int channel, float thresholdPercent);
   void updateDeadTime(int channel, float deadTimeUs);
   void updateMode(int channel, FilterMode mode);
+  // Nicht gegen gleichzeitige Pushes gesichert; aus ISRs über FilterIngest (FilterIngest.h)
   void onPulse(int channel);
+  void onPulses(int channel, unsigned long count); // Gesammelte Pulse, z. B. Zählerstand der Hardware
+  // Totzeitkorrigierte Zählrate über das Fenster des Kanals (Standard CPM_DEFAULT_WINDOW_MS)
   unsigned long getCPM(int channel);
+  // Dasselbe über windowMs (z. B. 10000, 60000); 0 = adaptiv, siehe PulseWindow::adaptive()
+  unsigned long getCPM(int channel, unsigned long windowMs);
+  void updateCPMWindow(int channel, unsigned long windowMs);
+  unsigned long getPulseCount(int channel) const; // Alle Pulse seit begin()
+  // constexpr (ab C++14), damit Tabellen schon beim Kompilieren geprüft werden (DAF_VALIDATE_CONFIGS)
+  static DAF_CONSTEXPR14 bool validateConfig(const FilterConfig& config);
+  template <size_t N>
+  static DAF_CONSTEXPR14 bool validateConfigs(const std::array<FilterConfig, N>& configs);
+  // Binärabbild aller Kanalzustände für RTC-Speicher oder Flash (Deep Sleep, Warmstart), siehe filter/Snapshot.h.
+  size_t snapshotSize() const;
+  size_t saveSnapshot(uint8_t* dst, size_t capacity) const; // Geschriebene Bytes, 0 wenn capacity zu klein
+  // Nach begin(). elapsedMs: Zeit zwischen saveSnapshot() und diesem Aufruf (z. B. Schlafdauer + millis()).
+  // 0 setzt die Zeitbasis so fort, als wäre seit dem Speichern keine Zeit vergangen.
+  // false bei fremdem Build, anderer Kanalzahl/Konfiguration oder falscher Prüfsumme;
+  // der Zustand ist dann derselbe wie nach begin().
+  bool restoreSnapshot(const uint8_t* src, size_t size, unsigned long elapsedMs = 0);
+#if defined(DAF_ENABLE_STATS)
+  // Zähler je Verwerfungsgrund, Laufzeit (Zyklen) und log2-Histogramm des Kanals.
+  // Aus jeder Task lesbar, ohne den Filter anzuhalten; false bei ungültigem
+  // Kanal oder wenn der Schreiber gerade unterbrochen ist (später erneut lesen).
+  bool getStats(int channel, FilterStats& stats) const;
+  void resetStats(int channel); // Nur aus der Task, die pusht
+#endif
 
 private:
+  enum SampleResult {
+    SAMPLE_FILTERED,        // Filter aktualisiert
+    SAMPLE_COUNTED,         // COUNT_MODE: Impuls gezählt
+    SAMPLE_RATE_LIMITED,    // Schneller als expectedIntervalMs / 2
+    SAMPLE_BELOW_THRESHOLD, // Änderung unter thresholdPercent
+    SAMPLE_OUTLIER,         // Von der Hampel/MAD-Vorstufe verworfen
+    SAMPLE_DEAD_TIME        // COUNT_MODE: innerhalb der Totzeit
+  };
+
+#if defined(DAF_FIXED_POINT)
+  typedef uint32_t Decay; // decayFactor mit 31 Nachkommabits (Q31_ONE = 1)
+#else
+  typedef float Decay;
+#endif
+
   struct FilterState {
     FilterType type;
     float normalFreqHz;
@@ -102,43 +239,180 @@ private:
     FilterMode mode;
     unsigned long startTime;
     unsigned long lastPushTime;
+    bool pushed;                   // Mindestens ein Sample angenommen (lastPushTime gültig)
     float filteredValue;
+#if defined(DAF_FIXED_POINT)
+    float fixedScale;              // Vollausschlag: Q31-Wert 1.0 entspricht fixedScale
+    float fixedInvScale;
+    q31_t fixedValue;              // Gefilterter Wert (Q31)
+    q31_t baseAlpha;               // EMA (Q31)
+    BasicHistoryRing<q31_t> history; // SMA/FIR-Historie (Q31)
+    std::vector<q15_t> baseCoeffs; // FIR (Q15)
+    int32_t firPastCoeffSum;       // FIR: Summe baseCoeffs[1..n-1] (Q15)
+    bool firSymmetric;             // FIR: linearphasig, gefaltet gerechnet
+    int64_t smaSum;                // SMA: exakte Fenstersumme, keine Drift
+#else
     float baseAlpha;
-    std::vector<float> history;
+    HistoryRing history;           // SMA/FIR-Historie, Kapazität = Anzahl Koeffizienten
     std::vector<float> baseCoeffs;
+    float firPastCoeffSum;         // FIR: Summe baseCoeffs[1..n-1] bei voller Historie
+    bool firSymmetric;             // FIR: linearphasig, gefaltet gerechnet
+    float smaSum;                  // SMA: laufende Fenstersumme (Kahan)
+    float smaCompensation;         // SMA: Kahan-Korrekturterm
+    unsigned int smaPushCount;     // SMA: Samples seit letzter Neuberechnung
+#endif
     volatile unsigned long pulseCount;
-#if defined(USE_KALMAN)
+    PulseWindow pulseWindow;       // COUNT_MODE: Pulsbuckets für fensterbasierte CPM
+    unsigned long cpmWindowMs;     // Fenster von getCPM(), 0 = adaptiv
+    StreamingMAD madWindow;        // Hampel-Vorstufe (Median/MAD der letzten Rohwerte)
+    Decimator decimator;           // DECIMATE: CIC und Polyphasen-FIR (auch im Festkomma-Build float)
+    std::vector<float> biquadCoeffs; // BIQUAD: je Sektion b0, b1, b2, a1, a2 (auch im Festkomma-Build float)
+    std::vector<float> biquadState;  // BIQUAD: je Sektion s1, s2, relativ zu biquadOffset
+    float biquadOffset;              // BIQUAD: Arbeitspunkt (erstes Sample), siehe biquadDecayedOutput()
+    float biquadGain;                // BIQUAD: Gleichanteil-Verstärkung
+    bool biquadPrimed;               // BIQUAD: Arbeitspunkt mit dem ersten Sample gesetzt
+#if defined(DAF_ENABLE_STATS)
+    ChannelStats stats;
+#endif
+#if defined(USE_KALMAN) && defined(DAF_FIXED_POINT)
+    uint32_t P;                    // Kovarianz P/R (UQ8.24)
+    uint32_t Q;                    // Prozessrauschen Q/R (UQ8.24)
+    q31_t x;
+#elif defined(USE_KALMAN)
     float P;
     float x;
 #endif
-#if defined(USE_LMS)
+#if defined(USE_LMS) && defined(DAF_FIXED_POINT)
+    int32_t coeffs[MAX_FILTER_LENGTH]; // Q28
+    q31_t inputBuffer[2 * MAX_FILTER_LENGTH]; // Gespiegelter Ring, neuester Wert ab bufferIndex
+    int bufferIndex;
+#elif defined(USE_LMS)
     float coeffs[MAX_FILTER_LENGTH];
-    float inputBuffer[MAX_FILTER_LENGTH];
+    float inputBuffer[2 * MAX_FILTER_LENGTH]; // Gespiegelter Ring, neuester Wert ab bufferIndex
     int bufferIndex;
 #endif
 #if defined(USE_RLS)
+    // RLS rechnet auch im DAF_FIXED_POINT-Build in float (Dynamikbereich von P)
     float coeffs[MAX_FILTER_LENGTH];
-    float inputBuffer[MAX_FILTER_LENGTH];
+    float inputBuffer[2 * MAX_FILTER_LENGTH]; // Gespiegelter Ring, neuester Wert ab bufferIndex
     int bufferIndex;
-    float P;
+    float P[MAX_FILTER_LENGTH * MAX_FILTER_LENGTH]; // Inverse Korrelationsmatrix, length x length zeilenweise
 #endif
   };
 
   std::vector<FilterState> _filters;
-  std::vector<FilterConfig> _configs;
-  String _sensorId;
+  std::vector<float> _outputs;   // Gefilterte Werte aller Kanäle, zusammenhängend
+  TableRef<FilterConfig> _configs;
+  SensorRegistry _sensors;
 
-  bool validateConfig(const FilterConfig& config);
   void initFilter(FilterState& state, const FilterConfig& config);
+  template <typename Archive, typename State>
+  static void transferState(Archive& ar, State& state);
+  uint32_t configHash() const;
   void initSMA(FilterState& state, int length);
   void initFIR(FilterState& state, const float* coeffs, int numCoeffs);
-  float calculateDecayFactor(const FilterState& state, unsigned long deltaT) const;
-  void updateEMA(FilterState& state, float value, float decayFactor);
-  void updateSMAorFIR(FilterState& state, float decayFactor);
+  void initBiquad(FilterState& state, const float* coeffs, int numCoeffs);
+#if defined(DAF_FIXED_POINT)
+  void initFIR(FilterState& state, const q15_t* coeffs, int numCoeffs);
+  void initFixedScale(FilterState& state, const FilterConfig& config, float value);
+  q31_t toFixed(const FilterState& state, float value) const;
+  void setFixedOutput(FilterState& state, q31_t value);
+#endif
+  SampleResult processSample(size_t channel, float value, unsigned long currentTime);
+  SampleResult filterSample(size_t channel, float value, unsigned long currentTime);
+  SampleResult decimateSample(size_t channel, float value, unsigned long currentTime, unsigned long deltaT);
+#if defined(DAF_ENABLE_STATS)
+  static StatsReason statsReason(SampleResult result);
+#endif
+  void applyFilter(FilterState& state, const FilterConfig& config, float value, Decay decayFactor);
+  template <typename Update>
+  BlockResult runBlock(FilterState& state, const FilterConfig& config, const float* values,
+                       const uint32_t* timestamps, size_t n, Update update);
+  unsigned long blockTimestamp(const FilterState& state, const uint32_t* timestamps, size_t i, size_t n, unsigned long now) const;
+  Decay calculateDecayFactor(const FilterState& state, unsigned long deltaT) const;
+  void updateEMA(FilterState& state, float value, Decay decayFactor);
+#if defined(USE_KALMAN)
+  void updateKalman(FilterState& state, const FilterConfig& config, float value);
+#endif
+#if defined(USE_LMS)
+  void updateLMS(FilterState& state, const FilterConfig& config, float value);
+#endif
+  void updateSMA(FilterState& state, float value, Decay decayFactor);
+  void updateFIR(FilterState& state, Decay decayFactor);
+  void updateBiquad(FilterState& state, float value, Decay decayFactor);
+#if defined(USE_RLS)
+  void updateRLS(FilterState& state, const FilterConfig& config, float value);
+#endif
+#if defined(USE_LMS) || defined(USE_RLS)
+  void pushToInputBuffer(FilterState& state, int length, float value);
+#endif
+#if !defined(DAF_FIXED_POINT)
+  void resyncSMASum(FilterState& state);
+#endif
   void pushToHistory(FilterState& state, float value);
+  void countPulses(FilterState& state, unsigned long count, unsigned long now);
   void initializeHistory(FilterState& state, float value);
   bool isSignificantChange(const FilterState& state, float value) const;
-  float calculateMAD(float* data, int windowSize);
+  bool isOutlier(const FilterState& state, const FilterConfig& config, float value) const;
 };
 
+DAF_CONSTEXPR14 bool DynamicAdaptiveFilterV2::validateConfig(const FilterConfig& config) {
+  if (config.normalFreqHz <= 0 || config.thresholdPercent < 0 || config.deadTimeUs < 0 || config.maxDecayTimeMs < 1000) {
+    return false;
+  }
+  if (config.type == FIR && (config.coeffs == nullptr || config.numCoeffs <= 0)) {
+    return false;
+  }
+  if (config.type == EMA || config.type == SMA) {
+    if (config.length < 1) return false;
+  }
+  if (config.type == BIQUAD && !biquadValid(config.coeffs, config.numCoeffs)) {
+    return false; // Ganze Sektionen, stabile Pole
+  }
+  if (config.fullScale < 0) {
+    return false;
+  }
+  if (config.type == DECIMATE) {
+    bool fir = config.coeffs != nullptr && config.numCoeffs > 0;
+    if (config.mode != VALUE_MODE || config.decimation < 1 || !decimatorCicValid(config.cicStages, config.cicDecimation)) {
+      return false;
+    }
+    if (!fir && (config.cicStages == 0 || config.decimation != 1)) {
+      return false; // Ohne Koeffizienten nur CIC
+    }
+  }
+#if defined(USE_KALMAN)
+  if (config.type == KALMAN && (config.Q <= 0 || config.R <= 0)) {
+    return false;
+  }
+#endif
+#if defined(USE_LMS)
+  if (config.type == LMS && (config.mu <= 0 || config.length > MAX_FILTER_LENGTH || config.length < 1)) {
+    return false;
+  }
+#endif
+#if defined(USE_RLS)
+  if (config.type == RLS && (config.lambda <= 0 || config.lambda > 1 || config.length > MAX_FILTER_LENGTH || config.length < 1)) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+template <size_t N>
+DAF_CONSTEXPR14 bool DynamicAdaptiveFilterV2::validateConfigs(const std::array<FilterConfig, N>& configs) {
+  for (size_t i = 0; i < N; ++i) {
+    if (!validateConfig(configs[i])) return false;
+  }
+  return true;
+}
+
+// Bricht den Build ab, wenn ein Kanal der Tabelle validateConfig() nicht besteht (ab C++14)
+#if __cplusplus >= 201402L
+#define DAF_VALIDATE_CONFIGS(table) \
+  static_assert(DynamicAdaptiveFilterV2::validateConfigs(table), #table ": ungültige FilterConfig")
+#else
+#define DAF_VALIDATE_CONFIGS(table) static_assert(true, #table)
+#endif
+
 #endif
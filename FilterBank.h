@@ -0,0 +1,188 @@
+#ifndef FILTER_BANK_H
+#define FILTER_BANK_H
+
+#include <Arduino.h>
+#include <array>
+#include <tuple>
+#include <utility>
+#include "filter/FilterPolicies.h"
+
+#ifndef MAD_WINDOW_LENGTH
+#define MAD_WINDOW_LENGTH 9 // Fensterlänge der Hampel/MAD-Vorstufe
+#endif
+
+// Filterbank mit zur Compile-Zeit festgelegtem Algorithmus je Kanal:
+//
+//   FilterBank<Kalman, Lms<4>, Fir<5>, Ema> bank(
+//     {{1.0f, 86400000, 0.0f, 3.0f}, Kalman(0.01f, 0.5f)},
+//     {{100.0f, 10000, 0.0f, 0.0f}, Lms<4>(0.01f)},
+//     {{10.0f, 60000, 1.0f, 0.0f}, Fir<5>(butterworth_lowpass_order2)},
+//     {{1.0f, 86400000, 2.0f, 0.0f}, Ema(10)});
+//
+// Kanal i verwendet die i-te Policy (filter/FilterPolicies.h). Es gibt keine
+// Laufzeit-Verzweigung über FilterType, der Aufruf wird inline aufgelöst, und
+// jeder Kanal speichert nur den Zustand seines Algorithmus. Die
+// USE_KALMAN/USE_LMS/USE_RLS-Einschränkung gilt hier nicht.
+//
+// Raten-Gate, decayFactor, Hampel-Vorstufe und Schmitt-Trigger verhalten sich
+// wie im VALUE_MODE von DynamicAdaptiveFilterV2. COUNT_MODE gibt es hier nicht.
+
+// Gemeinsame Einstellungen eines Kanals (entspricht den FilterConfig-Feldern)
+struct ChannelSettings {
+  float normalFreqHz;           // Normale Frequenz (Hz)
+  unsigned long maxDecayTimeMs; // Max. Decay-Zeit (ms)
+  float thresholdPercent;       // Schmitt-Trigger-Threshold (%)
+  float madThreshold;           // Schwellwert für MAD-Ausreißerfilter (0 = aus)
+};
+
+template <typename Policy>
+struct BankChannel {
+  ChannelSettings settings;
+  Policy filter;
+};
+
+template <typename... Policies>
+class FilterBank {
+  static_assert(sizeof...(Policies) > 0, "FilterBank braucht mindestens einen Kanal");
+
+public:
+  static constexpr size_t kChannels = sizeof...(Policies);
+
+  explicit FilterBank(const BankChannel<Policies>&... channels) : _slots(Slot<Policies>(channels)...) {
+    _outputs.fill(0.0f);
+  }
+
+  void begin() {
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+    if (!beginAll(std::index_sequence_for<Policies...>())) {
+      digitalWrite(LED_BUILTIN, LOW);
+      while (true);
+    }
+    digitalWrite(LED_BUILTIN, LOW);
+  }
+
+  // values[i] geht an Kanal firstChannel + i; timestamp == 0 -> millis().
+  // false bei ungültigem Bereich oder verworfenem Ausreißer.
+  bool pushSamples(const float* values, size_t count, unsigned long timestamp = 0, size_t firstChannel = 0) {
+    if (values == nullptr || count == 0 || firstChannel >= kChannels || count > kChannels - firstChannel) {
+      return false;
+    }
+    unsigned long currentTime = timestamp == 0 ? millis() : timestamp;
+    return pushRow(values, count, firstChannel, currentTime, std::index_sequence_for<Policies...>());
+  }
+  bool pushSamples(const std::array<float, kChannels>& values, unsigned long timestamp = 0) {
+    return pushSamples(values.data(), kChannels, timestamp, 0);
+  }
+
+  // Einzelner Kanal, Index zur Compile-Zeit
+  template <size_t I>
+  bool push(float value, unsigned long timestamp = 0) {
+    static_assert(I < kChannels, "Kanalindex außerhalb der FilterBank");
+    return processSample<I>(value, timestamp == 0 ? millis() : timestamp);
+  }
+
+  // Zugriff auf die Policy eines Kanals (z. B. Kalman::covariance(), Lms::coeffs())
+  template <size_t I>
+  auto& filter() { return std::get<I>(_slots).filter; }
+  template <size_t I>
+  const auto& filter() const { return std::get<I>(_slots).filter; }
+
+  float getFilteredValue(int channel) const {
+    if (channel < 0 || channel >= (int)kChannels) return 0.0f;
+    return _outputs[channel];
+  }
+  size_t copyFilteredValues(float* dst, size_t n) const {
+    if (dst == nullptr) return 0;
+    size_t count = min(n, kChannels);
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = _outputs[i];
+    }
+    return count;
+  }
+  const float* filteredValues() const { return _outputs.data(); }
+  static constexpr size_t channelCount() { return kChannels; }
+
+private:
+  template <typename Policy>
+  struct Slot {
+    Policy filter;
+    unsigned long expectedIntervalMs;
+    unsigned long maxDecayTimeMs;
+    float thresholdPercent;
+    float madThreshold;
+    float normalFreqHz;
+    unsigned long lastPushTime;
+    bool pushed;
+    StreamingMAD madWindow;
+
+    explicit Slot(const BankChannel<Policy>& channel)
+      : filter(channel.filter), expectedIntervalMs(0), maxDecayTimeMs(channel.settings.maxDecayTimeMs),
+        thresholdPercent(channel.settings.thresholdPercent), madThreshold(channel.settings.madThreshold),
+        normalFreqHz(channel.settings.normalFreqHz), lastPushTime(0), pushed(false) {}
+  };
+
+  std::tuple<Slot<Policies>...> _slots;
+  std::array<float, kChannels> _outputs;
+
+  // Prüfung und Initialwerte wie validateConfig()/initFilter()
+  template <size_t I>
+  bool beginChannel() {
+    auto& slot = std::get<I>(_slots);
+    if (slot.normalFreqHz <= 0 || slot.thresholdPercent < 0 || slot.maxDecayTimeMs < 1000 || !slot.filter.valid()) {
+      return false;
+    }
+    slot.normalFreqHz = max(0.01f, slot.normalFreqHz);
+    slot.expectedIntervalMs = static_cast<unsigned long>(1000.0f / slot.normalFreqHz);
+    slot.lastPushTime = 0;
+    slot.pushed = false;
+    bool useMad = slot.madThreshold > 0.0f || std::tuple_element<I, std::tuple<Policies...>>::type::kUsesMad;
+    slot.madWindow.reset(useMad ? MAD_WINDOW_LENGTH : 0);
+    slot.filter.reset();
+    _outputs[I] = 0.0f;
+    return true;
+  }
+
+  template <size_t... I>
+  bool beginAll(std::index_sequence<I...>) {
+    bool ok = true;
+    ((ok = ok && beginChannel<I>()), ...);
+    return ok;
+  }
+
+  template <size_t I>
+  bool processSample(float value, unsigned long currentTime) {
+    auto& slot = std::get<I>(_slots);
+    unsigned long deltaT = pushDeltaT(currentTime, slot.lastPushTime, slot.pushed);
+    if (deltaT < slot.expectedIntervalMs / 2) {
+      return true; // Zu schnelle Daten ignorieren
+    }
+    slot.lastPushTime = currentTime;
+    slot.pushed = true;
+
+    float decayFactor = filterDecayFactor(deltaT, slot.expectedIntervalMs, slot.maxDecayTimeMs);
+
+    if (slot.madWindow.enabled()) {
+      slot.madWindow.push(value);
+      if (filterIsOutlier(slot.madWindow, slot.madThreshold, value)) {
+        return false;
+      }
+    }
+    if (!filterSignificantChange(value, _outputs[I], slot.thresholdPercent)) {
+      return true;
+    }
+
+    FilterStep step = {value, _outputs[I], decayFactor, slot.madWindow};
+    _outputs[I] = slot.filter.update(step);
+    return true;
+  }
+
+  template <size_t... I>
+  bool pushRow(const float* values, size_t count, size_t firstChannel, unsigned long currentTime, std::index_sequence<I...>) {
+    bool success = true;
+    ((I >= firstChannel && I - firstChannel < count ? (success &= processSample<I>(values[I - firstChannel], currentTime)) : false), ...);
+    return success;
+  }
+};
+
+#endif
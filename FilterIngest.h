@@ -0,0 +1,167 @@
+#ifndef FILTER_INGEST_H
+#define FILTER_INGEST_H
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "filter/IngestQueue.h"
+#include <memory>
+
+// Eingangsstufe vor DynamicAdaptiveFilterV2 für ISRs und den zweiten ESP32-Kern.
+//
+// Produzenten (ISR, I2C-Callback, anderer Kern) rufen nur pushSample(),
+// pushParameter() und onPulse() auf: Samples und Parameteränderungen gehen
+// in eine lock-freie Queue, Pulse in atomare Zähler je Kanal. Der Filter wird
+// ausschließlich von der Task verändert, die drain() aufruft; sie arbeitet die
+// Queue in Blöcken ab und übergibt aufgelaufene Pulse gesammelt per onPulses().
+//
+// Queue = SpscQueue<IngestEvent, N> bei genau einem Produzenten,
+// MpscQueue<IngestEvent, N> bei mehreren (z. B. ISR + zweiter Kern).
+//
+//   FilterIngest<MpscQueue<IngestEvent, 256> > ingest(filter);
+//   void IRAM_ATTR pulseISR() { ingest.onPulse(0); }
+//   void loop() { ingest.drain(); ... }
+
+// Art eines Queue-Eintrags; Parameter entsprechen den update*()-Methoden
+enum IngestKind {
+  INGEST_SAMPLE,
+  INGEST_NORMAL_FREQ,
+  INGEST_LENGTH,
+  INGEST_MAX_DECAY_TIME,
+  INGEST_THRESHOLD,
+  INGEST_DEAD_TIME
+};
+
+struct IngestEvent {
+  uint32_t timestamp; // millis() beim Einreihen (nur INGEST_SAMPLE)
+  float value;        // Messwert bzw. neuer Parameterwert
+  uint16_t channel;   // Kanäle ab INGEST_MAX_CHANNEL + 1 nur für onPulse()
+  uint8_t kind;       // IngestKind
+};
+
+#define INGEST_DRAIN_BATCH 32     // Einträge pro popBatch() in drain()
+#define INGEST_MAX_CHANNEL 0xFFFF // Größter Kanal in IngestEvent::channel
+
+template <typename Queue>
+class FilterIngest {
+public:
+  explicit FilterIngest(DynamicAdaptiveFilterV2& filter)
+      : _filter(filter), _channels(filter.channelCount()), _pulses(new std::atomic<uint32_t>[filter.channelCount()]), _rejected(0) {
+    for (size_t i = 0; i < _channels; ++i) _pulses[i].store(0, std::memory_order_relaxed);
+  }
+
+  // --- Produzenten (ISR-fest) ---
+  // timestamp == 0 -> millis() beim Einreihen. false bei ungültigem Kanal oder voller Queue.
+  // Kanäle über INGEST_MAX_CHANNEL passen nicht in die Queue und zählen in dropped().
+  bool pushSample(size_t channel, float value, uint32_t timestamp = 0) {
+    if (channel >= _channels) return false;
+    if (channel > INGEST_MAX_CHANNEL) return reject(1);
+    IngestEvent event = {timestamp == 0 ? static_cast<uint32_t>(millis()) : timestamp, value, static_cast<uint16_t>(channel), INGEST_SAMPLE};
+    return _queue.push(event);
+  }
+
+  // values[i] an Kanal firstChannel + i, je INGEST_DRAIN_BATCH Einträge mit einer Reservierung.
+  // false bei ungültigem Bereich oder voller Queue (bereits eingereihte Blöcke bleiben).
+  bool pushSamples(const float* values, size_t count, uint32_t timestamp = 0, size_t firstChannel = 0) {
+    if (values == nullptr || firstChannel >= _channels || count > _channels - firstChannel) return false;
+    if (count > 0 && firstChannel + count - 1 > INGEST_MAX_CHANNEL) return reject(count);
+    if (timestamp == 0) timestamp = static_cast<uint32_t>(millis());
+    IngestEvent batch[INGEST_DRAIN_BATCH];
+    for (size_t done = 0; done < count;) {
+      size_t n = count - done < INGEST_DRAIN_BATCH ? count - done : INGEST_DRAIN_BATCH;
+      for (size_t i = 0; i < n; ++i) {
+        IngestEvent event = {timestamp, values[done + i], static_cast<uint16_t>(firstChannel + done + i), INGEST_SAMPLE};
+        batch[i] = event;
+      }
+      if (!_queue.pushBatch(batch, n)) return false;
+      done += n;
+    }
+    return true;
+  }
+
+  bool pushParameter(IngestKind kind, size_t channel, float value) {
+    if (channel >= _channels || kind == INGEST_SAMPLE) return false;
+    if (channel > INGEST_MAX_CHANNEL) return reject(1);
+    IngestEvent event = {0, value, static_cast<uint16_t>(channel), static_cast<uint8_t>(kind)};
+    return _queue.push(event);
+  }
+
+  void onPulse(size_t channel) {
+    if (channel >= _channels) return;
+    _pulses[channel].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void onPulses(size_t channel, uint32_t count) {
+    if (channel >= _channels) return;
+    _pulses[channel].fetch_add(count, std::memory_order_relaxed);
+  }
+
+  // --- Konsument (Filter-Task) ---
+  // Bis zu maxEvents Einträge verarbeiten und alle Pulse übernehmen.
+  // Höchstens so viele, wie beim Aufruf in der Queue lagen: was währenddessen
+  // eingereiht wird, kommt beim nächsten Aufruf dran, ein schneller Produzent
+  // hält loop() also nicht fest.
+  // Aufeinanderfolgende Samples benachbarter Kanäle mit gleichem Zeitstempel
+  // gehen in einem pushSamples()-Aufruf an den Filter. Rückgabe: verarbeitete Einträge.
+  size_t drain(size_t maxEvents = SIZE_MAX) {
+    IngestEvent batch[INGEST_DRAIN_BATCH];
+    float values[INGEST_DRAIN_BATCH];
+    size_t pending = _queue.size();
+    if (maxEvents > pending) maxEvents = pending;
+    size_t total = 0;
+    while (total < maxEvents) {
+      size_t want = maxEvents - total < INGEST_DRAIN_BATCH ? maxEvents - total : INGEST_DRAIN_BATCH;
+      size_t n = _queue.popBatch(batch, want);
+      size_t i = 0;
+      while (i < n) {
+        const IngestEvent& first = batch[i];
+        if (first.kind != INGEST_SAMPLE) {
+          applyParameter(first);
+          ++i;
+          continue;
+        }
+        size_t run = 0;
+        while (i + run < n && batch[i + run].kind == INGEST_SAMPLE && batch[i + run].timestamp == first.timestamp &&
+               batch[i + run].channel == first.channel + run) {
+          values[run] = batch[i + run].value;
+          ++run;
+        }
+        _filter.pushSamples(values, run, first.timestamp, first.channel);
+        i += run;
+      }
+      total += n;
+      if (n < want) break;
+    }
+    for (size_t c = 0; c < _channels; ++c) {
+      uint32_t count = _pulses[c].exchange(0, std::memory_order_relaxed);
+      if (count > 0) _filter.onPulses(static_cast<int>(c), count);
+    }
+    return total;
+  }
+
+  // Verworfene Einträge: volle Queue oder Kanal über INGEST_MAX_CHANNEL
+  uint32_t dropped() const { return _queue.dropped() + _rejected.load(std::memory_order_relaxed); }
+
+private:
+  DynamicAdaptiveFilterV2& _filter;
+  size_t _channels;
+  std::unique_ptr<std::atomic<uint32_t>[]> _pulses;
+  Queue _queue;
+  std::atomic<uint32_t> _rejected;
+
+  bool reject(size_t count) {
+    _rejected.fetch_add(static_cast<uint32_t>(count), std::memory_order_relaxed);
+    return false;
+  }
+
+  void applyParameter(const IngestEvent& event) {
+    int channel = event.channel;
+    switch (event.kind) {
+      case INGEST_NORMAL_FREQ: _filter.updateNormalFreq(channel, event.value); break;
+      case INGEST_LENGTH: _filter.updateLength(channel, static_cast<int>(event.value)); break;
+      case INGEST_MAX_DECAY_TIME: _filter.updateMaxDecayTime(channel, static_cast<unsigned long>(event.value)); break;
+      case INGEST_THRESHOLD: _filter.updateThreshold(channel, event.value); break;
+      case INGEST_DEAD_TIME: _filter.updateDeadTime(channel, event.value); break;
+    }
+  }
+};
+
+#endif
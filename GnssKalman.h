@@ -0,0 +1,243 @@
+#ifndef GNSS_KALMAN_H
+#define GNSS_KALMAN_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "filter/FilterMath.h"
+#include "filter/KalmanN.h"
+
+// Gemeinsamer Kalman-Filter für eine GNSS-Kanalgruppe:
+//
+//   GnssKalman gps(kalman_gps_neo_m10);   // params/params_sensors.h
+//   gps.begin();
+//   float row[6] = {lat, lon, alt, kmh, course, sats};
+//   gps.pushFix(row, 6, millis());
+//   gps.getFilteredValue(0);              // Lat
+//
+// Kanäle wie filter_gps_neo_*: Lat (Grad), Lon (Grad), Höhe (m),
+// Geschwindigkeit (km/h), Kurs (Grad), Satellitenanzahl (durchgereicht).
+//
+// Statt sechs unabhängiger Skalarfilter schätzt ein Modell konstanter
+// Geschwindigkeit (ConstantVelocityKalman<3>, Osten/Norden/Oben in Metern um
+// einen mitgeführten Ursprung) Position und Geschwindigkeit gemeinsam.
+// Geschwindigkeit und Kurs gehen als Geschwindigkeitsvektor in die Messung
+// ein, die Position läuft daher ohne die Verzögerung eines Tiefpasses mit.
+// Optional verbessert eine IMU die Vorhersage zwischen zwei Fixes
+// (pushAcceleration(), Beschleunigung in Ost/Nord/Oben ohne Schwerkraft).
+//
+// Lücken >= maxGapMs starten den Filter aus der nächsten Messung neu
+// (entspricht decayFactor 0), gate > 0 verwirft Fixes, deren Innovation
+// mehr als gate Standardabweichungen beträgt (wie madThreshold).
+
+#ifndef GNSS_METERS_PER_DEGREE
+#define GNSS_METERS_PER_DEGREE 111194.93f // Erdradius 6371 km * pi / 180
+#endif
+#define GNSS_RAD_PER_DEGREE 0.017453292f
+#define GNSS_RECENTER_M 1000.0f           // Ursprung nachführen, damit Meterwerte klein bleiben
+#define GNSS_INITIAL_VERTICAL_SIGMA 1.0f  // Startunsicherheit der Vertikalgeschwindigkeit (m/s)
+#define GNSS_ACCEL_HOLD_MS 100            // IMU-Wert so lange bis zum nächsten Fix fortschreiben
+
+struct GnssKalmanConfig {
+  float horizontalSigmaM;       // Lat/Lon: Standardabweichung (m)
+  float verticalSigmaM;         // Höhe: Standardabweichung (m)
+  float speedSigmaKmh;          // Geschwindigkeit: Standardabweichung (km/h)
+  float accelSigma;             // Prozessrauschen: Beschleunigung (m/s^2), mit IMU deren Rauschen
+  float minCourseSpeedKmh;      // Darunter gilt der Kurs nicht, gemessen wird Stillstand
+  unsigned long maxGapMs;       // Max. Lücke (ms), darüber Neustart aus der Messung
+  float gate;                   // Innovationstest in Standardabweichungen (0 = aus)
+};
+
+class GnssKalman {
+public:
+  static constexpr size_t kChannels = 6;
+
+  explicit GnssKalman(const GnssKalmanConfig& config) : _config(config), _filter(config.accelSigma) { reset(); }
+
+  // constexpr, damit Konfigurationen schon beim Kompilieren geprüft werden (DAF_VALIDATE_GNSS_CONFIG)
+  static constexpr bool validateConfig(const GnssKalmanConfig& config) {
+    return config.horizontalSigmaM > 0 && config.verticalSigmaM > 0 && config.speedSigmaKmh > 0 &&
+           config.accelSigma > 0 && config.minCourseSpeedKmh >= 0 && config.maxGapMs >= 1000 && config.gate >= 0;
+  }
+  bool valid() const { return validateConfig(_config); }
+
+  void begin() {
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, HIGH);
+    if (!valid()) {
+      digitalWrite(LED_BUILTIN, LOW);
+      while (true);
+    }
+    reset();
+    digitalWrite(LED_BUILTIN, LOW);
+  }
+
+  void reset() {
+    _filter.setAccelSigma(_config.accelSigma);
+    _primed = false;
+    setOrigin(0.0f, 0.0f);
+    _lastFixTime = 0;
+    _lastTime = 0;
+    _accelTime = 0;
+    for (size_t a = 0; a < 3; ++a) _accel[a] = 0.0f;
+    for (size_t i = 0; i < kChannels; ++i) _outputs[i] = 0.0f;
+  }
+
+  // values: mindestens Lat, Lon, Höhe, Geschwindigkeit, Kurs (count >= 5),
+  // optional Satellitenanzahl. timestamp == 0 -> millis().
+  // false bei zu kurzer Zeile oder verworfenem Fix.
+  bool pushFix(const float* values, size_t count, unsigned long timestamp = 0) {
+    if (values == nullptr || count < 5) return false;
+    unsigned long currentTime = timestamp == 0 ? millis() : timestamp;
+    if (count > 5) _outputs[5] = values[5];
+
+    if (!_primed || timeSince(currentTime, _lastFixTime) >= _config.maxGapMs) {
+      start(values, currentTime);
+      return true;
+    }
+    advance(currentTime);
+
+    float speed = values[3] / 3.6f;
+    bool moving = values[3] >= _config.minCourseSpeedKmh;
+    float course = values[4] * GNSS_RAD_PER_DEGREE;
+    float speedSigma = moving ? _config.speedSigmaKmh / 3.6f : max(_config.speedSigmaKmh, _config.minCourseSpeedKmh) / 3.6f;
+
+    KalmanVector<5> z;
+    z.m[0] = east(values[1]);
+    z.m[1] = north(values[0]);
+    z.m[2] = values[2];
+    z.m[3] = moving ? speed * sinf(course) : 0.0f;
+    z.m[4] = moving ? speed * cosf(course) : 0.0f;
+    KalmanMatrix<5, 6> H = KalmanMatrix<5, 6>::zero();
+    H(0, 0) = 1.0f;
+    H(1, 1) = 1.0f;
+    H(2, 2) = 1.0f;
+    H(3, 3) = 1.0f;
+    H(4, 4) = 1.0f;
+    KalmanMatrix<5, 5> R = KalmanMatrix<5, 5>::zero();
+    R(0, 0) = _config.horizontalSigmaM * _config.horizontalSigmaM;
+    R(1, 1) = R(0, 0);
+    R(2, 2) = _config.verticalSigmaM * _config.verticalSigmaM;
+    R(3, 3) = speedSigma * speedSigma;
+    R(4, 4) = R(3, 3);
+
+    bool accepted = _filter.update(z, H, R, _config.gate);
+    if (accepted) _lastFixTime = currentTime; // Dauerhaft verworfene Fixes enden nach maxGapMs im Neustart
+    recenter();
+    updateOutputs();
+    return accepted;
+  }
+
+  // IMU: Beschleunigung (m/s^2) in Ost, Nord, Oben ohne Schwerkraft.
+  // Schreibt den Zustand bis timestamp fort; vor dem ersten Fix ohne Wirkung.
+  void pushAcceleration(const float* accelEnu, unsigned long timestamp = 0) {
+    if (accelEnu == nullptr || !_primed) return;
+    unsigned long currentTime = timestamp == 0 ? millis() : timestamp;
+    advance(currentTime);
+    for (size_t a = 0; a < 3; ++a) _accel[a] = accelEnu[a];
+    _accelTime = currentTime;
+  }
+
+  float getFilteredValue(int channel) const {
+    if (channel < 0 || channel >= (int)kChannels) return 0.0f;
+    return _outputs[channel];
+  }
+  size_t copyFilteredValues(float* dst, size_t n) const {
+    if (dst == nullptr) return 0;
+    size_t count = min(n, kChannels);
+    for (size_t i = 0; i < count; ++i) {
+      dst[i] = _outputs[i];
+    }
+    return count;
+  }
+  const float* filteredValues() const { return _outputs; }
+  static constexpr size_t channelCount() { return kChannels; }
+
+  // Zustand in Metern/m/s (Ost, Nord, Oben) und letzte normierte Innovation
+  const ConstantVelocityKalman<3>& filter() const { return _filter; }
+
+private:
+  GnssKalmanConfig _config;
+  ConstantVelocityKalman<3> _filter;
+  bool _primed;
+  float _originLat;
+  float _originLon;
+  float _eastScale;             // Meter je Grad Länge am Ursprung
+  unsigned long _lastFixTime;
+  unsigned long _lastTime;      // Zeitpunkt des Zustands (Fix oder IMU)
+  unsigned long _accelTime;
+  float _accel[3];
+  float _outputs[kChannels];
+
+  static float wrapDegrees(float d) {
+    if (d > 180.0f) return d - 360.0f;
+    if (d < -180.0f) return d + 360.0f;
+    return d;
+  }
+
+  float north(float lat) const { return (lat - _originLat) * GNSS_METERS_PER_DEGREE; }
+  float east(float lon) const { return wrapDegrees(lon - _originLon) * _eastScale; }
+
+  void setOrigin(float lat, float lon) {
+    _originLat = lat;
+    _originLon = lon;
+    _eastScale = max(GNSS_METERS_PER_DEGREE * cosf(lat * GNSS_RAD_PER_DEGREE), 1.0f);
+  }
+
+  void start(const float* values, unsigned long currentTime) {
+    setOrigin(values[0], values[1]);
+    bool moving = values[3] >= _config.minCourseSpeedKmh;
+    float speed = moving ? values[3] / 3.6f : 0.0f;
+    float course = values[4] * GNSS_RAD_PER_DEGREE;
+    float position[3] = {0.0f, 0.0f, values[2]};
+    float velocity[3] = {speed * sinf(course), speed * cosf(course), 0.0f};
+    float horizontalVelocitySigma = max(_config.speedSigmaKmh, moving ? 0.0f : _config.minCourseSpeedKmh) / 3.6f;
+    float positionSigma[3] = {_config.horizontalSigmaM, _config.horizontalSigmaM, _config.verticalSigmaM};
+    float velocitySigma[3] = {horizontalVelocitySigma, horizontalVelocitySigma, GNSS_INITIAL_VERTICAL_SIGMA};
+    _filter.reset(position, velocity, positionSigma, velocitySigma);
+    _primed = true;
+    _lastFixTime = currentTime;
+    _lastTime = currentTime;
+    _accelTime = 0;
+    for (size_t a = 0; a < 3; ++a) _accel[a] = 0.0f;
+    for (size_t i = 0; i < 5; ++i) _outputs[i] = values[i];
+  }
+
+  // Vorhersage bis currentTime, mit dem letzten IMU-Wert, solange er aktuell ist
+  void advance(unsigned long currentTime) {
+    unsigned long deltaT = timeSince(currentTime, _lastTime);
+    if (deltaT == 0) return;
+    bool aided = _accelTime != 0 && timeSince(currentTime, _accelTime) <= GNSS_ACCEL_HOLD_MS;
+    _filter.predict(static_cast<float>(deltaT) * 0.001f, aided ? _accel : nullptr);
+    _lastTime = currentTime;
+  }
+
+  void recenter() {
+    float e = _filter.position(0), n = _filter.position(1);
+    if (fabsf(e) < GNSS_RECENTER_M && fabsf(n) < GNSS_RECENTER_M) return;
+    // Neuer Ursprung in float gerundet, verschoben wird um genau dessen Abstand
+    float lat = _originLat + n / GNSS_METERS_PER_DEGREE;
+    float lon = wrapDegrees(_originLon + e / _eastScale);
+    float shift[3] = {east(lon), north(lat), 0.0f};
+    setOrigin(lat, lon);
+    _filter.shiftPosition(shift);
+  }
+
+  void updateOutputs() {
+    float e = _filter.position(0), n = _filter.position(1);
+    float ve = _filter.velocity(0), vn = _filter.velocity(1);
+    _outputs[0] = _originLat + n / GNSS_METERS_PER_DEGREE;
+    _outputs[1] = wrapDegrees(_originLon + e / _eastScale);
+    _outputs[2] = _filter.position(2);
+    float speedKmh = sqrtf(ve * ve + vn * vn) * 3.6f;
+    _outputs[3] = speedKmh;
+    if (speedKmh >= _config.minCourseSpeedKmh) {
+      float course = atan2f(ve, vn) / GNSS_RAD_PER_DEGREE;
+      _outputs[4] = course < 0.0f ? course + 360.0f : course;
+    } // Sonst letzten Kurs halten
+  }
+};
+
+#define DAF_VALIDATE_GNSS_CONFIG(config) \
+  static_assert(GnssKalman::validateConfig(config), #config ": ungültige GnssKalmanConfig")
+
+#endif
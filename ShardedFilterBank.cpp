@@ -0,0 +1,140 @@
+#include "ShardedFilterBank.h"
+
+ShardedFilterBank::ShardedFilterBank(const std::vector<FilterConfig>& configs, size_t workers, size_t shards)
+    : _shardSize(1), _workerCount(1), _processed(0), _generation(0), _running(0), _stop(false) {
+  if (workers == 0) workers = max(1U, std::thread::hardware_concurrency());
+  if (shards == 0) shards = 4 * workers;
+  shards = max(static_cast<size_t>(1), min(shards, configs.size()));
+  _shardSize = configs.empty() ? 1 : (configs.size() + shards - 1) / shards;
+
+  for (size_t first = 0; first < configs.size(); first += _shardSize) {
+    Shard shard;
+    shard.firstChannel = first;
+    shard.count = min(_shardSize, configs.size() - first);
+    std::vector<FilterConfig> part(configs.begin() + first, configs.begin() + first + shard.count);
+    shard.filter.reset(new DynamicAdaptiveFilterV2(part));
+    shard.ingest.reset(new ShardIngest(*shard.filter));
+    _shards.push_back(std::move(shard));
+  }
+  _outputs.assign(configs.size(), 0.0f);
+  _workerCount = max(static_cast<size_t>(1), min(workers, _shards.size()));
+  _cursor.reset(new std::atomic<size_t>[_workerCount]);
+  for (size_t w = 0; w < _workerCount; ++w) _cursor[w].store(0);
+}
+
+ShardedFilterBank::~ShardedFilterBank() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _start.notify_all();
+  for (size_t i = 0; i < _threads.size(); ++i) _threads[i].join();
+}
+
+void ShardedFilterBank::begin() {
+  for (size_t s = 0; s < _shards.size(); ++s) {
+    _shards[s].filter->begin();
+    _shards[s].filter->copyFilteredValues(&_outputs[_shards[s].firstChannel], _shards[s].count);
+  }
+  for (size_t w = _threads.size() + 1; w < _workerCount; ++w) {
+    _threads.emplace_back(&ShardedFilterBank::workerLoop, this, w);
+  }
+}
+
+bool ShardedFilterBank::pushSamples(const float* values, size_t count, unsigned long timestamp, size_t firstChannel) {
+  if (values == nullptr || count == 0 || firstChannel >= _outputs.size() || count > _outputs.size() - firstChannel) {
+    return false;
+  }
+  uint32_t currentTime = static_cast<uint32_t>(timestamp == 0 ? millis() : timestamp);
+  bool success = true;
+  // Je Shard ein zusammenhängender Teilbereich, blockweise eingereiht
+  for (size_t i = 0; i < count;) {
+    size_t channel = firstChannel + i;
+    Shard& shard = _shards[channel / _shardSize];
+    size_t n = min(count - i, shard.firstChannel + shard.count - channel);
+    if (!shard.ingest->pushSamples(values + i, n, currentTime, channel - shard.firstChannel)) {
+      success = false;
+    }
+    i += n;
+  }
+  return success;
+}
+
+void ShardedFilterBank::onPulse(size_t channel) {
+  if (channel >= _outputs.size()) return;
+  Shard& shard = _shards[channel / _shardSize];
+  shard.ingest->onPulse(channel - shard.firstChannel);
+}
+
+size_t ShardedFilterBank::process() {
+  _processed.store(0, std::memory_order_relaxed);
+  for (size_t w = 0; w < _workerCount; ++w) _cursor[w].store(0, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _generation++;
+    _running = _threads.size();
+  }
+  _start.notify_all();
+  runWorker(0);
+  std::unique_lock<std::mutex> lock(_mutex);
+  _done.wait(lock, [this]() { return _running == 0; });
+  return _processed.load(std::memory_order_relaxed);
+}
+
+void ShardedFilterBank::workerLoop(size_t worker) {
+  unsigned long seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _start.wait(lock, [&]() { return _stop || _generation != seen; });
+      if (_stop) return;
+      seen = _generation;
+    }
+    runWorker(worker);
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (--_running == 0) _done.notify_one();
+  }
+}
+
+// Erst die eigenen Shards, dann reihum bei den anderen Workern stehlen
+void ShardedFilterBank::runWorker(size_t worker) {
+  size_t processed = 0;
+  for (size_t k = 0; k < _workerCount; ++k) {
+    size_t owner = (worker + k) % _workerCount;
+    for (size_t s = claimShard(owner); s < _shards.size(); s = claimShard(owner)) {
+      Shard& shard = _shards[s];
+      processed += shard.ingest->drain();
+      shard.filter->copyFilteredValues(&_outputs[shard.firstChannel], shard.count);
+    }
+  }
+  _processed.fetch_add(processed, std::memory_order_relaxed);
+}
+
+// Shards von owner: owner, owner + W, owner + 2W, ...; >= shardCount() wenn keiner mehr frei ist
+size_t ShardedFilterBank::claimShard(size_t owner) {
+  size_t index = _cursor[owner].fetch_add(1, std::memory_order_relaxed);
+  size_t shard = owner + index * _workerCount;
+  return shard < _shards.size() ? shard : _shards.size();
+}
+
+float ShardedFilterBank::getFilteredValue(int channel) const {
+  if (channel < 0 || channel >= (int)_outputs.size()) return 0.0f;
+  return _outputs[channel];
+}
+
+#if defined(DAF_ENABLE_STATS)
+bool ShardedFilterBank::getStats(int channel, FilterStats& stats) const {
+  if (channel < 0 || channel >= (int)_outputs.size()) return false;
+  const Shard& shard = _shards[channel / _shardSize];
+  return shard.filter->getStats(static_cast<int>(channel - shard.firstChannel), stats);
+}
+#endif
+
+size_t ShardedFilterBank::copyFilteredValues(float* dst, size_t n) const {
+  if (dst == nullptr) return 0;
+  size_t count = min(n, _outputs.size());
+  for (size_t i = 0; i < count; ++i) {
+    dst[i] = _outputs[i];
+  }
+  return count;
+}
@@ -0,0 +1,84 @@
+#ifndef SHARDED_FILTER_BANK_H
+#define SHARDED_FILTER_BANK_H
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "FilterIngest.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#define SHARD_QUEUE_CAPACITY 1024 // Einträge je Shard zwischen zwei process()-Aufrufen (Zweierpotenz)
+
+// Kanalbank für Tausende Kanäle, verteilt auf einen Worker-Pool (Gateway, Linux).
+//
+// Die Kanäle werden in zusammenhängende Shards zerlegt; jeder Shard ist eine
+// eigene DynamicAdaptiveFilterV2-Instanz mit FilterIngest-Queue davor.
+// pushSamples() reiht nur ein (lock-frei, aus beliebig vielen Threads),
+// process() lässt den Pool alle Shards abarbeiten: Worker w beginnt mit den
+// Shards w, w + W, w + 2W, ... und stiehlt danach Shards der anderen Worker,
+// bis keiner mehr übrig ist. Shards mit heißen (hochfrequenten) Kanälen
+// bremsen so nur einen Worker, die übrigen arbeiten den Rest ab.
+// Ergebnisse landen nach jedem process() zusammenhängend in filteredValues();
+// Kanalnummern und Werte sind dieselben wie bei einer einzelnen
+// DynamicAdaptiveFilterV2-Instanz über alle Kanäle.
+//
+// pushSamples()/onPulse() dürfen parallel zu process() laufen; Lesen der
+// Ausgaben nur aus dem Thread, der process() aufruft.
+class ShardedFilterBank {
+public:
+  // workers == 0 -> std::thread::hardware_concurrency(); shards == 0 -> 4 * workers
+  ShardedFilterBank(const std::vector<FilterConfig>& configs, size_t workers = 0, size_t shards = 0);
+  ~ShardedFilterBank();
+  void begin();
+  // values[i] geht an Kanal firstChannel + i; timestamp == 0 -> millis().
+  // false bei ungültigem Bereich oder voller Shard-Queue (dann fehlen einzelne Samples).
+  bool pushSamples(const float* values, size_t count, unsigned long timestamp = 0, size_t firstChannel = 0);
+  void onPulse(size_t channel);
+  // Alle eingereihten Einträge verarbeiten; blockiert bis alle Shards fertig sind.
+  // Rückgabe: verarbeitete Einträge.
+  size_t process();
+
+  float getFilteredValue(int channel) const;
+  size_t copyFilteredValues(float* dst, size_t n) const;
+  const float* filteredValues() const { return _outputs.data(); }
+  size_t channelCount() const { return _outputs.size(); }
+  size_t shardCount() const { return _shards.size(); }
+  size_t workerCount() const { return _workerCount; }
+#if defined(DAF_ENABLE_STATS)
+  bool getStats(int channel, FilterStats& stats) const; // Auch während process()
+#endif
+
+private:
+  typedef FilterIngest<MpscQueue<IngestEvent, SHARD_QUEUE_CAPACITY> > ShardIngest;
+
+  struct Shard {
+    size_t firstChannel;
+    size_t count;
+    std::unique_ptr<DynamicAdaptiveFilterV2> filter;
+    std::unique_ptr<ShardIngest> ingest;
+  };
+
+  std::vector<Shard> _shards;
+  size_t _shardSize;                  // Kanäle je Shard (letzter ggf. weniger)
+  std::vector<float> _outputs;
+  size_t _workerCount;
+
+  // Worker-Pool; Worker 0 ist der Thread, der process() aufruft
+  std::vector<std::thread> _threads;
+  std::unique_ptr<std::atomic<size_t>[]> _cursor; // Nächster eigener Shard je Worker
+  std::atomic<size_t> _processed;
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  unsigned long _generation;
+  size_t _running;
+  bool _stop;
+
+  void workerLoop(size_t worker);
+  void runWorker(size_t worker);
+  size_t claimShard(size_t owner);
+};
+
+#endif
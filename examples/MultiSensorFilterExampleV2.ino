@@ -5,6 +5,7 @@
 #include <Adafruit_SHT31.h>
 #include <Adafruit_MPU6050.h>
 #include "DynamicAdaptiveFilterV2.h"
+#include "FilterIngest.h"
 #include "params_sensors.h"
 
 #define SLAVE_ADDRESS 0x08
@@ -28,6 +29,9 @@ std::vector<FilterConfig> configs = {
 };
 
 DynamicAdaptiveFilterV2 filter(configs);
+SensorHandle bmeSensor, shtSensor, gpsSensor, imuSensor;
+// I2C-Callback ändert Parameter nur über die Queue, loop() übernimmt sie per drain()
+FilterIngest<SpscQueue<IngestEvent, 16> > ingest(filter);
 
 void setup() {
   Serial.begin(115200);
@@ -47,29 +51,31 @@ void setup() {
     Serial.println("MPU-6050 nicht gefunden!");
     while (true);
   }
+  filter.begin();
+  // Kanalbereiche einmalig binden, im loop() nur noch Handles
+  bmeSensor = filter.registerSensor("BME688", 0, 4);
+  shtSensor = filter.registerSensor("SHT45", 4, 2);
+  gpsSensor = filter.registerSensor("NEO-M10", 6, 6);
+  imuSensor = filter.registerSensor("MPU6050", 12, 6);
   Wire.begin(SLAVE_ADDRESS);
   Wire.onReceive(receiveEvent);
   Serial.println("Multi-Sensor-Filter gestartet...");
 }
 
 void loop() {
+  ingest.drain();
+
   // BME688 und SHT45: Alle 30 Minuten
   static unsigned long lastEnv = 0;
   if (millis() - lastEnv >= 1800000) {
     if (bme.performReading()) {
-      SensorData bmeData;
-      bmeData.values = {bme.temperature, bme.humidity, bme.pressure / 100.0f, bme.gas_resistance / 1000.0f};
-      bmeData.timestamp = millis();
-      bmeData.sensorId = "BME688";
-      filter.pushSensorData(bmeData);
+      std::array<float, 4> bmeValues = {bme.temperature, bme.humidity, bme.pressure / 100.0f, bme.gas_resistance / 1000.0f};
+      filter.pushSensor(bmeSensor, bmeValues, millis()); // Kanäle 0..3
     }
     float temp, hum;
     if (sht.readBoth(&temp, &hum)) {
-      SensorData shtData;
-      shtData.values = {temp, hum};
-      shtData.timestamp = millis();
-      shtData.sensorId = "SHT45";
-      filter.pushSensorData(shtData);
+      std::array<float, 2> shtValues = {temp, hum};
+      filter.pushSensor(shtSensor, shtValues, millis()); // Kanäle 4..5
     }
     lastEnv = millis();
   }
@@ -77,19 +83,15 @@ void loop() {
   // MPU-6050: 10 Hz
   sensors_event_t a, g, temp;
   mpu.getEvent(&a, &g, &temp);
-  SensorData imuData;
-  imuData.values = {a.acceleration.x, a.acceleration.y, a.acceleration.z,
-                    g.gyro.x, g.gyro.y, g.gyro.z};
-  imuData.timestamp = millis();
-  imuData.sensorId = "MPU6050";
-  filter.pushSensorData(imuData);
+  std::array<float, 6> imuValues = {a.acceleration.x, a.acceleration.y, a.acceleration.z,
+                                  g.gyro.x, g.gyro.y, g.gyro.z};
+  filter.pushSensor(imuSensor, imuValues, millis()); // Kanäle 12..17, ohne Heap-Allokation
 
   // GPS: 10 Hz
   while (gpsSerial.available() > 0) {
     if (gps.encode(gpsSerial.read())) {
       if (gps.location.isValid() && gps.altitude.isValid() && gps.speed.isValid()) {
-        SensorData gpsData;
-        gpsData.values = {
+        std::array<float, 6> gpsValues = {
           (float)gps.location.lat(),
           (float)gps.location.lng(),
           gps.altitude.meters(),
@@ -97,9 +99,7 @@ void loop() {
           gps.course.deg(),
           (float)gps.satellites.value()
         };
-        gpsData.timestamp = millis();
-        gpsData.sensorId = "NEO-M10";
-        filter.pushSensorData(gpsData);
+        filter.pushSensor(gpsSensor, gpsValues, millis()); // Kanäle 6..11
       }
     }
   }
@@ -107,7 +107,7 @@ void loop() {
   // Ausgabe alle 200 ms (5 Hz)
   static unsigned long lastPrint = 0;
   if (millis() - lastPrint > 200) {
-    auto filtered = filter.getFilteredValues();
+    const float* filtered = filter.filteredValues(); // Direkter Lesezugriff, keine Kopie
     Serial.printf("BME688: T=%.1f°C, H=%.1f%%, P=%.1fhPa, G=%.1fkOhm | "
                   "SHT45: T=%.1f°C, H=%.1f%% | "
                   "GPS: Lat=%.6f, Lon=%.6f, Alt=%.1fm, Spd=%.1fkm/h, Hdg=%.1f°, Sats=%.0f | "
@@ -131,9 +131,9 @@ void receiveEvent(int numBytes) {
   float value = *(float*)buf;
 
   switch (cmd) {
-    case 1: filter.updateNormalFreq(channel, value); break;
-    case 2: filter.updateLength(channel, (int)value); break;
-    case 3: filter.updateMaxDecayTime(channel, (unsigned long)value); break;
-    case 4: filter.updateThreshold(channel, value); break;
+    case 1: ingest.pushParameter(INGEST_NORMAL_FREQ, channel, value); break;
+    case 2: ingest.pushParameter(INGEST_LENGTH, channel, value); break;
+    case 3: ingest.pushParameter(INGEST_MAX_DECAY_TIME, channel, value); break;
+    case 4: ingest.pushParameter(INGEST_THRESHOLD, channel, value); break;
   }
 }
\ No newline at end of file
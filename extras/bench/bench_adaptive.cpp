@@ -0,0 +1,263 @@
+// RLS gegen LMS: Konvergenz und Kosten pro Sample.
+//
+// Beide laufen als Einkanal-FilterBank (Lms<N>/Rls<N> aus FilterPolicies.h,
+// bitgleich zu LMS/RLS in DynamicAdaptiveFilterV2) als Prädiktor des nächsten
+// Werts aus den letzten N Werten. Gemessen wird der quadratische
+// Prädiktionsfehler, geglättet über 64 Samples:
+//   mse     mittlerer Fehler im letzten Viertel, relativ zur Rauschvarianz
+//   conv    Samples, ab denen der geglättete Fehler dauerhaft unter dem
+//           Doppelten des besten mse aller Filter im Szenario bleibt
+// Szenario "Sprung" wechselt nach der Hälfte die Signaldynamik; conv zählt
+// dort ab dem Wechsel.
+//
+// Kosten: Rechenkern allein (lmsStep/rlsStep aus FilterMath.h) für N = 2..5
+// und kompletter Push-Pfad, in ns und TSC-Takten (nur x86).
+//
+// Aufruf: daf_bench_adaptive [--samples N] [--iters N]
+
+#include "FilterBank.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const float kSampleRateHz = 1000.0f;
+const unsigned long kIntervalMs = 1;
+const size_t kOrder = 4;
+const float kNoise = 0.05f;
+
+uint64_t readCycles() {
+#if defined(BENCH_HAS_TSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Deterministisches Gaußrauschen (LCG + Summe von 4 Gleichverteilungen)
+struct Noise {
+  uint32_t state;
+  float uniform() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+  }
+  float gauss() { return (uniform() + uniform() + uniform() + uniform()) * 1.7320508f; }
+};
+
+struct Scenario {
+  const char* name;
+  std::vector<float> signal;
+  size_t change; // Index des Dynamikwechsels, 0 = keiner
+};
+
+// AR(2)-Resonanz, Pole bei r * e^(+-jw); ohne Vorgeschichte 500 Samples Einschwingen
+void appendAr2(std::vector<float>& out, size_t n, float r, float w, Noise& noise) {
+  float a1 = 2.0f * r * std::cos(w);
+  float a2 = -r * r;
+  float x1 = out.empty() ? 0.0f : out.back();
+  float x2 = out.size() < 2 ? 0.0f : out[out.size() - 2];
+  size_t warmUp = out.empty() ? 500 : 0;
+  for (size_t i = 0; i < n + warmUp; ++i) {
+    float x = a1 * x1 + a2 * x2 + kNoise * noise.gauss();
+    if (i >= warmUp) out.push_back(x);
+    x2 = x1;
+    x1 = x;
+  }
+}
+
+std::vector<Scenario> makeScenarios(size_t samples) {
+  std::vector<Scenario> list;
+  Noise noise = {2024u};
+
+  Scenario hum = {"50-Hz-Brummen + Rauschen", {}, 0};
+  for (size_t i = 0; i < samples; ++i) {
+    float t = static_cast<float>(i) / kSampleRateHz;
+    hum.signal.push_back(1.0f + 0.8f * std::sin(2.0f * 3.14159265f * 50.0f * t) + kNoise * noise.gauss());
+  }
+  list.push_back(hum);
+
+  Scenario ar = {"AR(2)-Resonanz", {}, 0};
+  appendAr2(ar.signal, samples, 0.95f, 0.3f, noise);
+  list.push_back(ar);
+
+  Scenario jump = {"Sprung AR(2) w=0.3 -> 1.2", {}, samples / 2};
+  appendAr2(jump.signal, samples / 2, 0.95f, 0.3f, noise);
+  appendAr2(jump.signal, samples - samples / 2, 0.95f, 1.2f, noise);
+  list.push_back(jump);
+  return list;
+}
+
+ChannelSettings settings() {
+  return ChannelSettings{kSampleRateHz, 10000, 0.0f, 0.0f};
+}
+
+struct Run {
+  std::vector<double> smoothed; // Geglätteter quadratischer Fehler je Sample
+  double mse;                   // Letztes Viertel, relativ zur Rauschvarianz
+};
+
+template <typename Policy>
+Run predict(const Policy& policy, const Scenario& scenario) {
+  FilterBank<Policy> bank({settings(), policy});
+  HostClock::useManual(1000000ULL);
+  bank.begin();
+  const std::vector<float>& x = scenario.signal;
+  Run run;
+  run.smoothed.resize(x.size());
+  double smoothed = 0.0;
+  double tail = 0.0;
+  size_t tailCount = 0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    HostClock::advanceMillis(kIntervalMs);
+    bank.template push<0>(x[i], millis());
+    double e = static_cast<double>(x[i]) - bank.getFilteredValue(0);
+    smoothed = i == 0 ? e * e : smoothed + (e * e - smoothed) / 64.0;
+    run.smoothed[i] = smoothed;
+    if (i >= x.size() - x.size() / 4) {
+      tail += e * e;
+      tailCount++;
+    }
+  }
+  run.mse = tail / static_cast<double>(tailCount) / (static_cast<double>(kNoise) * kNoise);
+  return run;
+}
+
+// Samples ab scenario.change, nach denen der Fehler nicht mehr über target steigt
+size_t convergence(const Run& run, const Scenario& scenario, double target) {
+  size_t last = scenario.change;
+  for (size_t i = scenario.change; i < run.smoothed.size(); ++i) {
+    if (run.smoothed[i] >= target) last = i + 1;
+  }
+  return last - scenario.change;
+}
+
+// --- Kosten -------------------------------------------------------------------
+
+volatile float g_sink;
+
+struct Cost {
+  double ns;
+  double cycles;
+};
+
+template <typename Body>
+Cost measure(size_t iters, Body body) {
+  uint64_t c0 = readCycles();
+  Clock::time_point t0 = Clock::now();
+  body(iters);
+  double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  uint64_t c1 = readCycles();
+  Cost cost = {ns / static_cast<double>(iters), static_cast<double>(c1 - c0) / static_cast<double>(iters)};
+  return cost;
+}
+
+template <int N>
+void reportKernels(size_t iters, const std::vector<float>& signal) {
+  size_t mask = 1023;
+  Cost lms = measure(iters, [&](size_t n) {
+    float coeffs[N] = {};
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) acc += lmsStep(coeffs, &signal[i & mask], N, 0.01f, 0.5f, signal[(i & mask) + N]);
+    g_sink = acc;
+  });
+  Cost rls = measure(iters, [&](size_t n) {
+    float coeffs[N] = {};
+    float P[N * N];
+    float gain[N];
+    rlsReset(P, N);
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) acc += rlsStep(coeffs, P, gain, &signal[i & mask], N, 0.99f, signal[(i & mask) + N]);
+    g_sink = acc;
+  });
+  std::printf("%-16d %10.2f %10.1f %10.2f %10.1f %8.2f\n", N, lms.ns, lms.cycles, rls.ns, rls.cycles, rls.ns / lms.ns);
+}
+
+template <typename Policy>
+Cost pushCost(const Policy& policy, const std::vector<float>& signal, size_t iters) {
+  FilterBank<Policy> bank({settings(), policy});
+  HostClock::useManual(1000000ULL);
+  bank.begin();
+  unsigned long now = millis();
+  return measure(iters, [&](size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      now += kIntervalMs;
+      bank.template push<0>(signal[i % signal.size()], now);
+    }
+    g_sink = bank.getFilteredValue(0);
+  });
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t samples = 20000;
+  size_t iters = 2000000;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+      samples = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+      iters = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--samples N] [--iters N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (samples < 1100) samples = 1100;
+  if (iters == 0) iters = 1;
+
+  std::vector<Scenario> scenarios = makeScenarios(samples);
+  std::printf("Prädiktor der Ordnung %zu, %zu Samples, Rauschen sigma = %.2f\n\n", kOrder, samples, kNoise);
+  std::printf("%-16s", "filter");
+  for (size_t s = 0; s < scenarios.size(); ++s) std::printf(" %17.17s", scenarios[s].name);
+  std::printf("\n%-16s", "");
+  for (size_t s = 0; s < scenarios.size(); ++s) std::printf(" %8s %8s", "conv", "mse");
+  std::printf("\n");
+  const char* labels[] = {"LMS mu=0.01", "LMS mu=0.1", "RLS l=0.99", "RLS l=0.999"};
+  const size_t kFilters = sizeof(labels) / sizeof(labels[0]);
+  std::vector<std::vector<Run> > runs(kFilters);
+  for (size_t s = 0; s < scenarios.size(); ++s) {
+    runs[0].push_back(predict(Lms<kOrder>(0.01f), scenarios[s]));
+    runs[1].push_back(predict(Lms<kOrder>(0.1f), scenarios[s]));
+    runs[2].push_back(predict(Rls<kOrder>(0.99f), scenarios[s]));
+    runs[3].push_back(predict(Rls<kOrder>(0.999f), scenarios[s]));
+  }
+  for (size_t f = 0; f < kFilters; ++f) {
+    std::printf("%-16s", labels[f]);
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+      double best = runs[0][s].mse;
+      for (size_t g = 1; g < kFilters; ++g) best = std::min(best, runs[g][s].mse);
+      double target = 2.0 * best * static_cast<double>(kNoise) * kNoise;
+      std::printf(" %8zu %8.2f", convergence(runs[f][s], scenarios[s], target), runs[f][s].mse);
+    }
+    std::printf("\n");
+  }
+
+  const std::vector<float>& signal = scenarios[1].signal;
+  std::printf("\n%-16s %10s %10s %10s %10s %8s\n", "kernel N", "LMS ns", "LMS takte", "RLS ns", "RLS takte", "RLS/LMS");
+  reportKernels<2>(iters, signal);
+  reportKernels<3>(iters, signal);
+  reportKernels<4>(iters, signal);
+  reportKernels<5>(iters, signal);
+
+  Cost lmsPush = pushCost(Lms<kOrder>(0.01f), signal, iters);
+  Cost rlsPush = pushCost(Rls<kOrder>(0.99f), signal, iters);
+  std::printf("\n%-16s %10s %10s\n", "push path", "ns", "takte");
+  std::printf("%-16s %10.2f %10.1f\n", "Lms<4>", lmsPush.ns, lmsPush.cycles);
+  std::printf("%-16s %10.2f %10.1f\n", "Rls<4>", rlsPush.ns, rlsPush.cycles);
+#if !defined(BENCH_HAS_TSC)
+  std::printf("(keine Taktzählung auf dieser Plattform)\n");
+#endif
+  return 0;
+}
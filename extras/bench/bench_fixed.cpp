@@ -0,0 +1,324 @@
+// Vergleich des DAF_FIXED_POINT-Builds (Q15/Q31) mit dem Float-Pfad.
+//
+// Gegen die Festkomma-Bibliothek gelinkt. Als Float-Referenz dient
+// FilterBank<...> aus FilterBank.h: Die Policies rechnen bitgleich zu
+// DynamicAdaptiveFilterV2 ohne DAF_FIXED_POINT und hängen nicht an den Makros.
+// Beide Wege bekommen dieselben Signale (Sinus + Rauschen, einzelne Lücken
+// für den decayFactor) und dieselbe manuelle Uhr.
+//
+// Geprüfte Fehlergrenze je Kanal, relativ zum Vollausschlag (fullScale):
+//   EMA, SMA, KALMAN   1e-6             (Q31-Rundung)
+//   FIR                N * 2^-16 + 1e-6 (Q15-Rundung der N Koeffizienten)
+//   LMS                1e-3             (adaptiv, Rundung wirkt auf die Koeffizienten zurück)
+// Exit-Code 1, wenn ein Kanal die Grenze überschreitet.
+//
+// Die Zeitmessung vergleicht die Rechenkerne (FilterMath.h gegen FixedPoint.h)
+// sowie den gesamten Push-Pfad. Auf dem Host mit FPU ist float meist schneller;
+// aussagekräftig ist der Faktor auf Kernen ohne FPU (ESP32-C3/C6), wo jede
+// float-Operation eine Softfloat-Routine ist.
+//
+// Aufruf: daf_bench_fixed_<variante> [--samples N] [--iters N]
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "FilterBank.h"
+#include "filter/FIR_coefficients.h"
+#include "filter/FIR_coefficients_q15.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if !defined(DAF_FIXED_POINT)
+#error "bench_fixed.cpp braucht den DAF_FIXED_POINT-Build"
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const float kSampleRateHz = 100.0f;
+const unsigned long kIntervalMs = 10;
+
+// Kanal: Name, Signal (Offset, Amplitude, Rauschen), Vollausschlag, Fehlergrenze
+struct Channel {
+  const char* name;
+  float offset;
+  float amplitude;
+  float noise;
+  float fullScale;
+  float bound;
+};
+
+const float kFirBound = 5.0f / 65536.0f + 1e-6f;
+
+#if defined(USE_KALMAN)
+const Channel kChannels[] = {
+  {"EMA(10) Temperatur", 22.0f, 2.0f, 0.2f, 64.0f, 1e-6f},
+  {"SMA(16) Druck hPa", 1013.0f, 5.0f, 0.5f, 2048.0f, 1e-6f},
+  {"FIR butterworth2", 3.3f, 1.0f, 0.05f, 8.0f, kFirBound},
+  {"FIR notch_50hz", 0.0f, 1.5f, 0.3f, 4.0f, kFirBound},
+  {"KALMAN(0.01,0.1)", 48.1f, 0.001f, 0.0005f, 0.0f, 1e-6f},
+};
+typedef FilterBank<Ema, Sma<16>, Fir<5>, Fir<5>, Kalman> Reference;
+#elif defined(USE_LMS)
+const Channel kChannels[] = {
+  {"EMA(10) Temperatur", 22.0f, 2.0f, 0.2f, 64.0f, 1e-6f},
+  {"SMA(16) Druck hPa", 1013.0f, 5.0f, 0.5f, 2048.0f, 1e-6f},
+  {"FIR butterworth2", 3.3f, 1.0f, 0.05f, 8.0f, kFirBound},
+  {"LMS(4) Brummen", 1.0f, 0.5f, 0.05f, 0.0f, 1e-3f},
+};
+typedef FilterBank<Ema, Sma<16>, Fir<5>, Lms<4>> Reference;
+#else
+#error "bench_fixed.cpp braucht USE_KALMAN oder USE_LMS"
+#endif
+
+const size_t kNumChannels = sizeof(kChannels) / sizeof(kChannels[0]);
+
+FilterConfig baseConfig(FilterType type, const Channel& channel) {
+  FilterConfig c = {};
+  c.type = type;
+  c.normalFreqHz = kSampleRateHz;
+  c.maxDecayTimeMs = 10000;
+  c.mode = VALUE_MODE;
+  c.fullScale = channel.fullScale;
+  return c;
+}
+
+std::vector<FilterConfig> makeConfigs() {
+  std::vector<FilterConfig> configs;
+  FilterConfig ema = baseConfig(EMA, kChannels[0]);
+  ema.length = 10;
+  configs.push_back(ema);
+  FilterConfig sma = baseConfig(SMA, kChannels[1]);
+  sma.length = 16;
+  configs.push_back(sma);
+  FilterConfig fir = baseConfig(FIR, kChannels[2]);
+  fir.coeffs = butterworth_lowpass_order2;
+  fir.numCoeffs = 5;
+  configs.push_back(fir);
+#if defined(USE_KALMAN)
+  FilterConfig notch = baseConfig(FIR, kChannels[3]);
+  notch.coeffs = notch_50hz;
+  notch.numCoeffs = 5;
+  configs.push_back(notch);
+  FilterConfig kalman = baseConfig(KALMAN, kChannels[4]);
+  kalman.Q = 0.01f;
+  kalman.R = 0.1f;
+  kalman.initialState = 48.0f;
+  configs.push_back(kalman);
+#else
+  FilterConfig lms = baseConfig(LMS, kChannels[3]);
+  lms.length = 4;
+  lms.mu = 0.01f;
+  configs.push_back(lms);
+#endif
+  return configs;
+}
+
+ChannelSettings settings() {
+  return ChannelSettings{kSampleRateHz, 10000, 0.0f, 0.0f};
+}
+
+Reference makeReference() {
+#if defined(USE_KALMAN)
+  return Reference({settings(), Ema(10)}, {settings(), Sma<16>()}, {settings(), Fir<5>(butterworth_lowpass_order2)},
+                   {settings(), Fir<5>(notch_50hz)}, {settings(), Kalman(0.01f, 0.1f, 48.0f)});
+#else
+  return Reference({settings(), Ema(10)}, {settings(), Sma<16>()}, {settings(), Fir<5>(butterworth_lowpass_order2)},
+                   {settings(), Lms<4>(0.01f)});
+#endif
+}
+
+// Deterministisches Rauschen (LCG), gleich für beide Wege
+struct Noise {
+  uint32_t state;
+  float next() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<float>(state >> 8) / 8388608.0f - 1.0f;
+  }
+};
+
+struct Signal {
+  std::vector<float> rows;          // samples x kNumChannels
+  std::vector<unsigned long> times; // Zeitstempel in ms
+};
+
+Signal makeSignal(size_t samples) {
+  Signal s;
+  s.rows.resize(samples * kNumChannels);
+  s.times.resize(samples);
+  Noise noise = {12345u};
+  unsigned long t = 1000;
+  for (size_t i = 0; i < samples; ++i) {
+    // Alle 500 Samples eine Lücke von 3 s, damit der decayFactor < 1 wird
+    t += (i % 500 == 499) ? 3000 : kIntervalMs;
+    s.times[i] = t;
+    for (size_t c = 0; c < kNumChannels; ++c) {
+      const Channel& ch = kChannels[c];
+      float phase = 2.0f * 3.14159265f * static_cast<float>(i) / (40.0f + 13.0f * c);
+      s.rows[i * kNumChannels + c] = ch.offset + ch.amplitude * std::sin(phase) + ch.noise * noise.next();
+    }
+  }
+  return s;
+}
+
+template <typename Filter>
+double run(Filter& filter, const Signal& signal, std::vector<float>* outputs) {
+  size_t samples = signal.times.size();
+  if (outputs) outputs->resize(samples * kNumChannels);
+  HostClock::useManual(1000000ULL);
+  filter.begin();
+  Clock::time_point t0 = Clock::now();
+  for (size_t i = 0; i < samples; ++i) {
+    filter.pushSamples(&signal.rows[i * kNumChannels], kNumChannels, signal.times[i]);
+    if (outputs) filter.copyFilteredValues(&(*outputs)[i * kNumChannels], kNumChannels);
+  }
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / (static_cast<double>(samples) * kNumChannels);
+}
+
+// Vollausschlag wie initFixedScale(), wenn fullScale = 0
+float effectiveScale(const Channel& channel, float firstValue) {
+  if (channel.fullScale > 0.0f) return channel.fullScale;
+  float scale = 1.0f;
+  while (scale < 4.0f * std::fabs(firstValue)) scale *= 2.0f;
+  return scale;
+}
+
+// --- Rechenkerne ----------------------------------------------------------------
+
+volatile float g_sinkFloat;
+volatile q31_t g_sinkFixed;
+
+template <typename Body>
+double timeKernel(size_t iters, Body body) {
+  Clock::time_point t0 = Clock::now();
+  body(iters);
+  return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / static_cast<double>(iters);
+}
+
+void benchKernels(size_t iters) {
+  std::vector<float> input(1024);
+  std::vector<q31_t> inputQ(1024);
+  Noise noise = {777u};
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = 0.25f * noise.next();
+    inputQ[i] = floatToQ31(input[i]);
+  }
+  const int kTaps = 5;
+  std::vector<float> hist(input.begin(), input.begin() + kTaps);
+  std::vector<q31_t> histQ(inputQ.begin(), inputQ.begin() + kTaps);
+
+  std::printf("\n%-18s %12s %12s %8s\n", "kernel", "float ns", "fixed ns", "ratio");
+
+  double emaF = timeKernel(iters, [&](size_t n) {
+    float y = 0.0f;
+    for (size_t i = 0; i < n; ++i) y = emaStep(y, input[i & 1023], 0.18f, 0.9f);
+    g_sinkFloat = y;
+  });
+  double emaQ = timeKernel(iters, [&](size_t n) {
+    q31_t y = 0;
+    q31_t alpha = floatToQ31(0.18f);
+    for (size_t i = 0; i < n; ++i) y = emaStepQ31(y, inputQ[i & 1023], alpha, 1932735283u);
+    g_sinkFixed = y;
+  });
+  std::printf("%-18s %12.2f %12.2f %8.2f\n", "ema", emaF, emaQ, emaF / emaQ);
+
+  double firF = timeKernel(iters, [&](size_t n) {
+    float acc = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+      hist[i % kTaps] = input[i & 1023];
+      acc += firDecayedOutput(butterworth_lowpass_order2, kTaps, 0.83f, hist.data(), kTaps, 0.9f);
+    }
+    g_sinkFloat = acc;
+  });
+  double firQ = timeKernel(iters, [&](size_t n) {
+    int64_t acc = 0;
+    for (size_t i = 0; i < n; ++i) {
+      histQ[i % kTaps] = inputQ[i & 1023];
+      acc += firDecayedOutputQ31(butterworth_lowpass_order2_q15.data(), kTaps, 27197, histQ.data(), kTaps, 1932735283u);
+    }
+    g_sinkFixed = static_cast<q31_t>(acc);
+  });
+  std::printf("%-18s %12.2f %12.2f %8.2f\n", "fir(5)", firF, firQ, firF / firQ);
+
+  double kalF = timeKernel(iters, [&](size_t n) {
+    float x = 0.0f, P = 1.0f;
+    for (size_t i = 0; i < n; ++i) kalmanStep(x, P, 0.01f, 0.1f, input[i & 1023]);
+    g_sinkFloat = x;
+  });
+  double kalQ = timeKernel(iters, [&](size_t n) {
+    q31_t x = 0;
+    uint32_t p = floatToUQ24(10.0f), q = floatToUQ24(0.1f);
+    for (size_t i = 0; i < n; ++i) kalmanStepQ31(x, p, q, inputQ[i & 1023]);
+    g_sinkFixed = x;
+  });
+  std::printf("%-18s %12.2f %12.2f %8.2f\n", "kalman", kalF, kalQ, kalF / kalQ);
+
+  double lmsF = timeKernel(iters, [&](size_t n) {
+    float coeffs[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < n; ++i) lmsStep(coeffs, &input[i & 1019], 4, 0.01f, 0.1f, input[(i + 4) & 1023]);
+    g_sinkFloat = coeffs[0];
+  });
+  double lmsQ = timeKernel(iters, [&](size_t n) {
+    int32_t coeffs[4] = {0, 0, 0, 0};
+    int32_t step = floatToQ16(0.1f);
+    for (size_t i = 0; i < n; ++i) lmsStepQ31(coeffs, &inputQ[i & 1019], 4, step, inputQ[(i + 4) & 1023]);
+    g_sinkFixed = coeffs[0];
+  });
+  std::printf("%-18s %12.2f %12.2f %8.2f\n", "lms(4)", lmsF, lmsQ, lmsF / lmsQ);
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t samples = 20000;
+  size_t iters = 2000000;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+      samples = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+      iters = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--samples N] [--iters N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (samples == 0) samples = 1;
+  if (iters == 0) iters = 1;
+
+  Signal signal = makeSignal(samples);
+  std::vector<FilterConfig> configs = makeConfigs();
+  DynamicAdaptiveFilterV2 fixed(configs);
+  Reference reference = makeReference();
+
+  std::vector<float> fixedOut, floatOut;
+  run(fixed, signal, &fixedOut);
+  run(reference, signal, &floatOut);
+
+  std::printf("%-20s %10s %14s %12s  %s\n", "channel", "fullScale", "max |err|", "bound", "");
+  bool ok = true;
+  for (size_t c = 0; c < kNumChannels; ++c) {
+    float scale = effectiveScale(kChannels[c], signal.rows[c]);
+    double worst = 0.0;
+    for (size_t i = 0; i < samples; ++i) {
+      double err = std::fabs(static_cast<double>(fixedOut[i * kNumChannels + c]) - floatOut[i * kNumChannels + c]) / scale;
+      if (err > worst) worst = err;
+    }
+    bool pass = worst <= kChannels[c].bound;
+    ok = ok && pass;
+    std::printf("%-20s %10.0f %14.3e %12.3e  %s\n", kChannels[c].name, scale, worst, kChannels[c].bound, pass ? "ok" : "FEHLER");
+  }
+
+  double fixedNs = run(fixed, signal, nullptr);
+  double floatNs = run(reference, signal, nullptr);
+  std::printf("\n%-36s %10s\n", "push path", "ns/sample");
+  std::printf("%-36s %10.2f\n", "FilterBank<...> (float)", floatNs);
+  std::printf("%-36s %10.2f\n", "DynamicAdaptiveFilterV2 (Q15/Q31)", fixedNs);
+  std::printf("%-36s %10.2f\n", "speedup", floatNs / fixedNs);
+
+  benchKernels(iters);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+// GNSS-Kanalgruppe: sechs Skalarfilter gegen GnssKalman.
+//
+// Simulierte Fahrt (10 Hz, 200 s): Stillstand, Anfahren auf 50 km/h,
+// Kurve, Beschleunigen auf 100 km/h mit Steigung, Kurve, Bremsen bis zum
+// Stillstand. Der Empfänger meldet Position mit weißem Rauschen (horizontal
+// 1.5 m, vertikal 3 m) und Geschwindigkeit/Kurs aus einem verrauschten
+// Geschwindigkeitsvektor (0.1 m/s je Achse), wie Doppler-Messungen.
+//
+// Varianten:
+//   filter_gps_neo_m10    Profil aus params_sensors.h, unverändert
+//   KALMAN Q/R=x          skalarer Kalman je Kanal (Random Walk), ohne Schwelle
+//   GnssKalman            kalman_gps_neo_m10, Modell konstanter Geschwindigkeit
+//   GnssKalman + IMU      zusätzlich Beschleunigung mit 100 Hz (Rauschen 0.1 m/s^2)
+//
+// Spalten:
+//   pos      RMS-Fehler der Position (m, horizontal)
+//   lag      mittlerer Fehler entlang der Fahrtrichtung (m, negativ = hinterher)
+//   alt      RMS-Fehler der Höhe (m)
+//   speed    RMS-Fehler der Geschwindigkeit (km/h)
+//   course   RMS-Fehler des Kurses bei >= 5 km/h (Grad)
+//   ns/fix   Rechenzeit je Fix (alle Kanäle), Budget bei 10 Hz: 100 ms
+//
+// Aufruf: daf_bench_gnss [--repeat N]
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "GnssKalman.h"
+#include "params/params_sensors.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double kFixRateHz = 10.0;
+const unsigned long kFixIntervalMs = 100;
+const unsigned long kImuIntervalMs = 10;
+const double kDurationS = 200.0;
+const double kOriginLat = 48.137;
+const double kOriginLon = 11.575;
+const double kHorizontalNoiseM = 1.5;
+const double kVerticalNoiseM = 3.0;
+const double kVelocityNoise = 0.1;
+const double kImuNoise = 0.1;
+const double kPi = 3.14159265358979323846;
+
+// Deterministisches Gaußrauschen (LCG + Summe von 4 Gleichverteilungen)
+struct Noise {
+  uint32_t state;
+  double uniform() {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / 16777216.0 - 0.5;
+  }
+  double gauss() { return (uniform() + uniform() + uniform() + uniform()) * 1.7320508; }
+};
+
+struct Truth {
+  double east, north, up;      // m
+  double ve, vn;               // m/s
+  double ae, an, au;           // m/s^2
+};
+
+// Fahrprofil: Bahnbeschleunigung (m/s^2), Drehrate (Grad/s), Steigrate (m/s)
+void profile(double t, double& accel, double& turnRate, double& climb) {
+  accel = 0.0;
+  turnRate = 0.0;
+  climb = 0.0;
+  if (t >= 10 && t < 20) accel = 50.0 / 3.6 / 10.0;
+  if (t >= 60 && t < 70) turnRate = 9.0;
+  if (t >= 70 && t < 90) accel = 50.0 / 3.6 / 20.0;
+  if (t >= 90 && t < 150) climb = 0.5;
+  if (t >= 150 && t < 160) turnRate = -6.0;
+  if (t >= 160 && t < 180) accel = -100.0 / 3.6 / 20.0;
+}
+
+// Wahre Bahn in 1-ms-Schritten integriert, abgelegt je IMU-Intervall
+std::vector<Truth> makeTruth() {
+  std::vector<Truth> track;
+  double e = 0, n = 0, u = 520.0, speed = 0, heading = 45.0;
+  size_t steps = static_cast<size_t>(kDurationS * 1000.0);
+  for (size_t ms = 0; ms <= steps; ++ms) {
+    double t = ms * 0.001, accel, turnRate, climb;
+    profile(t, accel, turnRate, climb);
+    double h = heading * kPi / 180.0;
+    if (ms % kImuIntervalMs == 0) {
+      double omega = turnRate * kPi / 180.0;
+      Truth s;
+      s.east = e;
+      s.north = n;
+      s.up = u;
+      s.ve = speed * sin(h);
+      s.vn = speed * cos(h);
+      s.ae = accel * sin(h) + speed * omega * cos(h);
+      s.an = accel * cos(h) - speed * omega * sin(h);
+      s.au = 0.0;
+      track.push_back(s);
+    }
+    e += speed * sin(h) * 0.001;
+    n += speed * cos(h) * 0.001;
+    u += climb * 0.001;
+    speed = std::max(0.0, speed + accel * 0.001);
+    heading += turnRate * 0.001;
+  }
+  return track;
+}
+
+double metersPerDegree() { return static_cast<double>(GNSS_METERS_PER_DEGREE); }
+
+struct Fix {
+  unsigned long timestamp;
+  size_t truthIndex;
+  float row[6];
+};
+
+std::vector<Fix> makeFixes(const std::vector<Truth>& track) {
+  std::vector<Fix> fixes;
+  Noise noise = {12345u};
+  double eastScale = metersPerDegree() * cos(kOriginLat * kPi / 180.0);
+  size_t perFix = kFixIntervalMs / kImuIntervalMs;
+  for (size_t i = 0; i < track.size(); i += perFix) {
+    const Truth& s = track[i];
+    double ve = s.ve + kVelocityNoise * noise.gauss();
+    double vn = s.vn + kVelocityNoise * noise.gauss();
+    double course = atan2(ve, vn) * 180.0 / kPi;
+    Fix f;
+    f.timestamp = 1000 + static_cast<unsigned long>(i * kImuIntervalMs);
+    f.truthIndex = i;
+    f.row[0] = static_cast<float>(kOriginLat + (s.north + kHorizontalNoiseM * noise.gauss()) / metersPerDegree());
+    f.row[1] = static_cast<float>(kOriginLon + (s.east + kHorizontalNoiseM * noise.gauss()) / eastScale);
+    f.row[2] = static_cast<float>(s.up + kVerticalNoiseM * noise.gauss());
+    f.row[3] = static_cast<float>(sqrt(ve * ve + vn * vn) * 3.6);
+    f.row[4] = static_cast<float>(course < 0 ? course + 360.0 : course);
+    f.row[5] = 18.0f;
+    fixes.push_back(f);
+  }
+  return fixes;
+}
+
+struct Errors {
+  double pos2 = 0, lag = 0, alt2 = 0, speed2 = 0, course2 = 0;
+  size_t n = 0, nLag = 0, nCourse = 0;
+
+  void add(const Truth& s, const float* out) {
+    double eastScale = metersPerDegree() * cos(kOriginLat * kPi / 180.0);
+    double de = (static_cast<double>(out[1]) - kOriginLon) * eastScale - s.east;
+    double dn = (static_cast<double>(out[0]) - kOriginLat) * metersPerDegree() - s.north;
+    double speed = sqrt(s.ve * s.ve + s.vn * s.vn);
+    pos2 += de * de + dn * dn;
+    alt2 += (out[2] - s.up) * (out[2] - s.up);
+    speed2 += (out[3] - speed * 3.6) * (out[3] - speed * 3.6);
+    n++;
+    if (speed > 1.0) {
+      lag += (de * s.ve + dn * s.vn) / speed;
+      nLag++;
+    }
+    if (speed * 3.6 >= 5.0) {
+      double course = atan2(s.ve, s.vn) * 180.0 / kPi;
+      double d = fmod(static_cast<double>(out[4]) - course + 540.0, 360.0) - 180.0;
+      course2 += d * d;
+      nCourse++;
+    }
+  }
+};
+
+struct Result {
+  Errors errors;
+  double nsPerFix;
+};
+
+// Filter: pushFix(fix) und imu(truth, timestamp, noise); Fehler ab 5 s
+template <typename Filter>
+Result run(Filter& filter, const std::vector<Truth>& track, const std::vector<Fix>& fixes, size_t repeat, bool imu) {
+  Result result;
+  double total = 0.0;
+  size_t pushes = 0;
+  size_t perFix = kFixIntervalMs / kImuIntervalMs;
+  for (size_t r = 0; r < repeat; ++r) {
+    filter.begin();
+    Noise noise = {777u};
+    Errors errors;
+    for (const Fix& f : fixes) {
+      Clock::time_point t0 = Clock::now();
+      filter.pushFix(f);
+      total += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+      pushes++;
+      if (f.timestamp >= 6000) errors.add(track[f.truthIndex], filter.outputs());
+      if (imu) {
+        for (size_t k = 1; k < perFix && f.truthIndex + k < track.size(); ++k) {
+          const Truth& s = track[f.truthIndex + k];
+          float accel[3] = {static_cast<float>(s.ae + kImuNoise * noise.gauss()),
+                            static_cast<float>(s.an + kImuNoise * noise.gauss()),
+                            static_cast<float>(s.au + kImuNoise * noise.gauss())};
+          filter.pushAcceleration(accel, f.timestamp + k * kImuIntervalMs);
+        }
+      }
+    }
+    result.errors = errors;
+  }
+  result.nsPerFix = total / static_cast<double>(pushes);
+  return result;
+}
+
+struct RuntimeFilter {
+  DynamicAdaptiveFilterV2 filter;
+  float out[6];
+
+  explicit RuntimeFilter(const std::vector<FilterConfig>& configs) : filter(configs) {}
+  void begin() { filter.begin(); }
+  void pushFix(const Fix& f) { filter.pushSamples(f.row, 6, f.timestamp); }
+  void pushAcceleration(const float*, unsigned long) {}
+  const float* outputs() {
+    filter.copyFilteredValues(out, 6);
+    return out;
+  }
+};
+
+struct GroupFilter {
+  GnssKalman filter;
+
+  explicit GroupFilter(const GnssKalmanConfig& config) : filter(config) {}
+  void begin() { filter.begin(); }
+  void pushFix(const Fix& f) { filter.pushFix(f.row, 6, f.timestamp); }
+  void pushAcceleration(const float* accel, unsigned long timestamp) { filter.pushAcceleration(accel, timestamp); }
+  const float* outputs() { return filter.filteredValues(); }
+};
+
+// Skalarer Kalman je Kanal, R aus dem Messrauschen, Q = ratio * R
+std::vector<FilterConfig> scalarKalman(float ratio) {
+  double degree = metersPerDegree();
+  double eastDegree = degree * cos(kOriginLat * kPi / 180.0);
+  float r[6] = {static_cast<float>(kHorizontalNoiseM / degree), static_cast<float>(kHorizontalNoiseM / eastDegree),
+                static_cast<float>(kVerticalNoiseM), static_cast<float>(kVelocityNoise * 3.6), 2.0f, 1.0f};
+  std::vector<FilterConfig> configs;
+  for (size_t i = 0; i < 6; ++i) {
+    FilterConfig c = {};
+    c.type = KALMAN;
+    c.normalFreqHz = static_cast<float>(kFixRateHz);
+    c.maxDecayTimeMs = 10000;
+    c.mode = VALUE_MODE;
+    c.R = r[i] * r[i];
+    c.Q = ratio * c.R;
+    configs.push_back(c);
+  }
+  return configs;
+}
+
+void print(const char* name, const Result& r) {
+  const Errors& e = r.errors;
+  std::printf("%-22s %8.2f %8.2f %8.2f %8.2f %8.2f %10.0f\n", name, sqrt(e.pos2 / e.n), e.nLag ? e.lag / e.nLag : 0.0,
+              sqrt(e.alt2 / e.n), sqrt(e.speed2 / e.n), e.nCourse ? sqrt(e.course2 / e.nCourse) : 0.0, r.nsPerFix);
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t repeat = 20;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+      repeat = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--repeat N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (repeat == 0) repeat = 1;
+
+  std::vector<Truth> track = makeTruth();
+  std::vector<Fix> fixes = makeFixes(track);
+
+  std::printf("%-22s %8s %8s %8s %8s %8s %10s\n", "variant", "pos", "lag", "alt", "speed", "course", "ns/fix");
+
+  RuntimeFilter profile(std::vector<FilterConfig>(filter_gps_neo_m10.begin(), filter_gps_neo_m10.end()));
+  print("filter_gps_neo_m10", run(profile, track, fixes, repeat, false));
+
+  const float ratios[] = {0.01f, 0.1f, 1.0f};
+  for (float ratio : ratios) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "KALMAN Q/R=%g", ratio);
+    RuntimeFilter scalar(scalarKalman(ratio));
+    print(name, run(scalar, track, fixes, repeat, false));
+  }
+
+  GroupFilter group(kalman_gps_neo_m10);
+  print("GnssKalman", run(group, track, fixes, repeat, false));
+
+  GnssKalmanConfig imuConfig = kalman_gps_neo_m10;
+  imuConfig.accelSigma = static_cast<float>(kImuNoise) * 2.0f;
+  GroupFilter aided(imuConfig);
+  print("GnssKalman + IMU", run(aided, track, fixes, repeat, true));
+
+  std::printf("sizeof(GnssKalman) = %zu Bytes\n", sizeof(GnssKalman));
+  return 0;
+}
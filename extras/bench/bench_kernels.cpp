@@ -0,0 +1,180 @@
+// Benchmark der DSP-Kernels (filter/DspKernels.h).
+//
+// Misst Taps/ns für das FIR-Skalarprodukt, das gefaltete Skalarprodukt
+// symmetrischer Kerne (Taps des ungefalteten Kerns pro ns, also direkt
+// vergleichbar) und das LMS-Update (y += a*x) je verfügbarem Backend, für die
+// Tabellen aus filter/FIR_coefficients.h, mit filter/FirDesign.h entworfene
+// Tiefpässe und synthetische Filter mit 32..256 Taps. "dispatch" ist der Pfad,
+// den die Bibliothek tatsächlich nimmt (inkl. inline-Skalar für kurze Filter).
+//
+// Aufruf: daf_bench_kernels [--min-ms N] [--csv]
+
+#include "filter/DspKernels.h"
+#include "filter/FIR_coefficients.h"
+#include "filter/FirDesign.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+struct Case {
+  std::string name;
+  std::vector<float> coeffs;
+};
+
+struct Backend {
+  std::string name;
+  DspDotFn dot;
+  DspScaledAddFn scaledAdd;
+  DspFoldedDotFn foldedDot;
+};
+
+float dispatchDot(const float* a, const float* b, size_t n) { return dspDotProduct(a, b, n); }
+void dispatchScaledAdd(float* y, float alpha, const float* x, size_t n) { dspScaledAdd(y, alpha, x, n); }
+float dispatchFoldedDot(const float* c, const float* lo, const float* hi, size_t n) { return dspFoldedDot(c, lo, hi, n); }
+
+volatile float g_sink = 0.0f;
+
+// Wiederholt die Messung, bis mindestens minMs vergangen sind
+double measureDot(DspDotFn fn, const std::vector<float>& coeffs, const std::vector<float>& signal, double minMs) {
+  size_t n = coeffs.size();
+  size_t span = signal.size() - n;
+  size_t iters = 1024;
+  for (;;) {
+    float acc = 0.0f;
+    Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+      acc += fn(coeffs.data(), signal.data() + (i % span), n);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    g_sink = g_sink + acc;
+    if (ns >= minMs * 1e6) return static_cast<double>(n) * static_cast<double>(iters) / ns;
+    iters *= 2;
+  }
+}
+
+// Symmetrischer Kern mit n Taps: n/2 Paare (+ Mitte bei ungeradem n, skalar)
+double measureFoldedDot(DspFoldedDotFn fn, const std::vector<float>& coeffs, const std::vector<float>& signal, double minMs) {
+  size_t n = coeffs.size();
+  size_t pairs = n / 2;
+  size_t span = signal.size() - n;
+  size_t iters = 1024;
+  for (;;) {
+    float acc = 0.0f;
+    Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+      const float* x = signal.data() + (i % span);
+      acc += fn(coeffs.data(), x, x + n - pairs, pairs);
+      if (n & 1) acc += coeffs[pairs] * x[pairs];
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    g_sink = g_sink + acc;
+    if (ns >= minMs * 1e6) return static_cast<double>(n) * static_cast<double>(iters) / ns;
+    iters *= 2;
+  }
+}
+
+double measureScaledAdd(DspScaledAddFn fn, size_t n, const std::vector<float>& signal, double minMs) {
+  std::vector<float> y(n, 0.0f);
+  size_t span = signal.size() - n;
+  size_t iters = 1024;
+  for (;;) {
+    Clock::time_point t0 = Clock::now();
+    for (size_t i = 0; i < iters; ++i) {
+      fn(y.data(), 1e-6f, signal.data() + (i % span), n);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    g_sink = g_sink + y[0];
+    if (ns >= minMs * 1e6) return static_cast<double>(n) * static_cast<double>(iters) / ns;
+    iters *= 2;
+  }
+}
+
+template <size_t N>
+Case tableCase(const char* name, const float (&table)[N]) {
+  return Case{name, std::vector<float>(table, table + N)};
+}
+
+template <size_t N>
+Case designCase(const char* name, const DesignArray<float, N>& table) {
+  return Case{name, std::vector<float>(table.begin(), table.end())};
+}
+
+}
+
+int main(int argc, char** argv) {
+  double minMs = 20.0;
+  bool csv = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+      minMs = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--min-ms N] [--csv]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<Case> cases;
+  cases.push_back(tableCase("chebyshev_lowpass_order1", chebyshev_lowpass_order1));
+  cases.push_back(tableCase("chebyshev_lowpass_order2", chebyshev_lowpass_order2));
+  cases.push_back(tableCase("chebyshev_lowpass_order3", chebyshev_lowpass_order3));
+  cases.push_back(tableCase("bessel_lowpass_order1", bessel_lowpass_order1));
+  cases.push_back(tableCase("bessel_lowpass_order2", bessel_lowpass_order2));
+  cases.push_back(tableCase("bessel_lowpass_order3", bessel_lowpass_order3));
+  cases.push_back(tableCase("butterworth_lowpass_order1", butterworth_lowpass_order1));
+  cases.push_back(tableCase("butterworth_lowpass_order2", butterworth_lowpass_order2));
+  cases.push_back(tableCase("butterworth_lowpass_order3", butterworth_lowpass_order3));
+  cases.push_back(tableCase("notch_50hz", notch_50hz));
+  cases.push_back(designCase("firLowPass<31>", firLowPass<31>(100.0f, 5.0f)));
+  cases.push_back(designCase("firLowPass<63>", firLowPass<63>(100.0f, 5.0f)));
+  cases.push_back(designCase("firLowPass<127>", firLowPass<127>(100.0f, 5.0f)));
+  cases.push_back(designCase("firNotch<61>", firNotch<61>(200.0f, 50.0f, 20.0f)));
+  const size_t synthetic[] = {32, 64, 128, 256};
+  for (size_t n : synthetic) {
+    std::vector<float> c(n, 1.0f / static_cast<float>(n));
+    cases.push_back(Case{"uniform_" + std::to_string(n), c});
+  }
+
+  std::vector<float> signal(8192);
+  for (size_t i = 0; i < signal.size(); ++i) {
+    signal[i] = std::sin(0.01f * static_cast<float>(i)) + 0.001f * static_cast<float>(i % 17);
+  }
+
+  std::vector<Backend> backends;
+  size_t count = 0;
+  const DspKernels* list = dspAvailableKernels(&count);
+  for (size_t i = 0; i < count; ++i) {
+    backends.push_back(Backend{list[i].name, list[i].dot, list[i].scaledAdd, list[i].foldedDot});
+  }
+  backends.push_back(Backend{std::string("dispatch(") + dspKernels().name + ")", dispatchDot, dispatchScaledAdd, dispatchFoldedDot});
+
+  if (csv) {
+    std::printf("case,taps,backend,dot_taps_per_ns,folded_taps_per_ns,scaled_add_taps_per_ns\n");
+  } else {
+    std::printf("%-28s %5s %-18s %14s %14s %18s\n", "case", "taps", "backend", "dot taps/ns", "folded taps/ns", "scaledAdd taps/ns");
+  }
+  for (const Case& c : cases) {
+    for (const Backend& b : backends) {
+      double dot = measureDot(b.dot, c.coeffs, signal, minMs);
+      double folded = measureFoldedDot(b.foldedDot, c.coeffs, signal, minMs);
+      double axpy = measureScaledAdd(b.scaledAdd, c.coeffs.size(), signal, minMs);
+      if (csv) {
+        std::printf("%s,%zu,%s,%.3f,%.3f,%.3f\n", c.name.c_str(), c.coeffs.size(), b.name.c_str(), dot, folded, axpy);
+      } else {
+        std::printf("%-28s %5zu %-18s %14.3f %14.3f %18.3f\n", c.name.c_str(), c.coeffs.size(), b.name.c_str(), dot, folded,
+                    axpy);
+      }
+    }
+  }
+  return 0;
+}
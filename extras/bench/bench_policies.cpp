@@ -0,0 +1,118 @@
+// Vergleich FilterBank<Policies...> gegen DynamicAdaptiveFilterV2 mit
+// identischer Kanalbelegung (EMA, FIR, SMA, Kalman im Wechsel).
+//
+// Beide Varianten rechnen bitgleich; gemessen wird nur der Unterschied
+// zwischen Laufzeit-Dispatch über FilterType und Compile-Zeit-Policies.
+// Die Uhr läuft manuell, damit jedes Sample gefiltert wird.
+//
+// Aufruf: daf_bench_policies [--iters N] [--mad X]
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "FilterBank.h"
+#include "filter/FIR_coefficients.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const float kSampleRateHz = 100.0f;
+const unsigned long kIntervalMs = 10;
+const size_t kChannels = 8;
+
+float g_madThreshold = 0.0f;
+
+FilterConfig baseConfig(FilterType type) {
+  FilterConfig c = {};
+  c.type = type;
+  c.normalFreqHz = kSampleRateHz;
+  c.maxDecayTimeMs = 10000;
+  c.mode = VALUE_MODE;
+  c.madThreshold = g_madThreshold;
+  return c;
+}
+
+std::vector<FilterConfig> makeConfigs() {
+  std::vector<FilterConfig> configs;
+  for (size_t i = 0; i < kChannels / 4; ++i) {
+    FilterConfig ema = baseConfig(EMA);
+    ema.length = 10;
+    FilterConfig fir = baseConfig(FIR);
+    fir.coeffs = butterworth_lowpass_order2;
+    fir.numCoeffs = 5;
+    FilterConfig sma = baseConfig(SMA);
+    sma.length = 16;
+    FilterConfig kalman = baseConfig(KALMAN);
+    kalman.Q = 0.01f;
+    kalman.R = 0.1f;
+    configs.push_back(ema);
+    configs.push_back(fir);
+    configs.push_back(sma);
+    configs.push_back(kalman);
+  }
+  return configs;
+}
+
+ChannelSettings settings() {
+  return ChannelSettings{kSampleRateHz, 10000, 0.0f, g_madThreshold};
+}
+
+typedef FilterBank<Ema, Fir<5>, Sma<16>, Kalman, Ema, Fir<5>, Sma<16>, Kalman> Bank;
+
+Bank makeBank() {
+  return Bank({settings(), Ema(10)}, {settings(), Fir<5>(butterworth_lowpass_order2)}, {settings(), Sma<16>()},
+              {settings(), Kalman(0.01f, 0.1f)}, {settings(), Ema(10)}, {settings(), Fir<5>(butterworth_lowpass_order2)},
+              {settings(), Sma<16>()}, {settings(), Kalman(0.01f, 0.1f)});
+}
+
+template <typename Filter>
+double run(Filter& filter, size_t iters) {
+  HostClock::useManual(1000000ULL);
+  filter.begin();
+  float row[kChannels];
+  double total = 0.0;
+  for (size_t it = 0; it < iters; ++it) {
+    HostClock::advanceMillis(kIntervalMs);
+    for (size_t c = 0; c < kChannels; ++c) {
+      row[c] = 20.0f + 0.01f * static_cast<float>((it + c * 7) % 1000);
+    }
+    unsigned long now = millis();
+    Clock::time_point t0 = Clock::now();
+    filter.pushSamples(row, kChannels, now);
+    total += std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  }
+  return total / (static_cast<double>(iters) * kChannels);
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t iters = 200000;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+      iters = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--mad") == 0 && i + 1 < argc) {
+      g_madThreshold = static_cast<float>(std::atof(argv[++i]));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--iters N] [--mad X]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iters == 0) iters = 1;
+
+  DynamicAdaptiveFilterV2 runtime(makeConfigs());
+  Bank bank = makeBank();
+  double runtimeNs = run(runtime, iters);
+  double bankNs = run(bank, iters);
+
+  std::printf("%-36s %10s\n", "variant", "ns/sample");
+  std::printf("%-36s %10.2f\n", "DynamicAdaptiveFilterV2", runtimeNs);
+  std::printf("%-36s %10.2f\n", "FilterBank<Ema,Fir<5>,Sma<16>,Kalman>", bankNs);
+  std::printf("sizeof(FilterBank) = %zu Bytes (ohne MAD-Fenster)\n", sizeof(Bank));
+  return 0;
+}
@@ -0,0 +1,368 @@
+// Mikrobenchmark für pushSensorData()/getFilteredValues() pro Filtertyp.
+//
+// Misst pro Szenario (Filtertyp x Kanalanzahl x Fensterlänge):
+//   - Durchsatz (Samples/s) und mittlere Kosten pro Sample
+//   - Latenz-Perzentile eines pushSensorData()-Aufrufs
+//   - Heap-Allokationen pro Sample (globaler operator new wird gezählt)
+//
+// Die Uhr des Arduino-Shims läuft manuell und wird pro Push um genau ein
+// Abtastintervall weitergestellt, damit kein Sample am Raten-Gate hängen
+// bleibt und decayFactor konstant 1 ist.
+//
+// Mit --raw werden statt pushSensorData()/getFilteredValues() die
+// allokationsfreien pushSamples()/copyFilteredValues() gemessen, mit --bank
+// dieselben Aufrufe auf DynamicAdaptiveFilterBank (SoA-Layout). --mad setzt
+// madThreshold für alle Kanäle (Standard 0 = Hampel-Vorstufe aus), damit die
+// Zeilen je Filtertyp nur den Filter messen. Die Hampel-Vorstufe hat eine
+// eigene Zeile "HAMPEL+EMA" (madThreshold 3.0 vor EMA/5); die Differenz zur
+// Zeile EMA/5 sind ihre Kosten.
+//
+// Als daf_bench_stats (DAF_ENABLE_STATS) folgt jeder Zeile die Statistik von
+// Kanal 0 aus getStats(): Samples je Grund, Zyklen und belegte Histogramm-Buckets.
+//
+// Aufruf: daf_bench_<variante> [--iters N] [--filter TEXT] [--csv] [--raw] [--bank] [--mad X]
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "DynamicAdaptiveFilterBank.h"
+#include "filter/FIR_coefficients.h"
+#include "filter/FirDesign.h"
+#include "filter/BiquadDesign.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// --- Allokationszähler ------------------------------------------------------
+
+static bool g_countAllocs = false;
+static size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+  if (g_countAllocs) ++g_allocCount;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) {
+  if (g_countAllocs) ++g_allocCount;
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+// --- Szenarien ----------------------------------------------------------------
+
+namespace {
+
+const float kSampleRateHz = 100.0f;
+const unsigned long kIntervalMs = 10;
+
+struct Scenario {
+  std::string name;
+  FilterType type;
+  int length;
+  const float* coeffs;
+  int numCoeffs;
+  size_t channels;
+  int decimation;    // DECIMATE
+  int cicStages;
+  int cicDecimation;
+  float madThreshold; // > 0: überschreibt --mad (Hampel-Zeile)
+};
+
+struct Result {
+  double nsPerSample;
+  double p50, p90, p99, maxNs;
+  double samplesPerSec;
+  double allocsPerSample;
+  double getNsPerCall;
+  double getAllocsPerCall;
+};
+
+struct FirTable {
+  const char* name;
+  const float* coeffs;
+  int numCoeffs;
+};
+
+#define FIR_TABLE(t) { #t, t, static_cast<int>(sizeof(t) / sizeof(t[0])) }
+const FirTable kFirTables[] = {
+  FIR_TABLE(chebyshev_lowpass_order1), FIR_TABLE(chebyshev_lowpass_order2), FIR_TABLE(chebyshev_lowpass_order3),
+  FIR_TABLE(bessel_lowpass_order1), FIR_TABLE(bessel_lowpass_order2), FIR_TABLE(bessel_lowpass_order3),
+  FIR_TABLE(butterworth_lowpass_order1), FIR_TABLE(butterworth_lowpass_order2), FIR_TABLE(butterworth_lowpass_order3),
+  FIR_TABLE(notch_50hz),
+};
+#undef FIR_TABLE
+
+// DECIMATE gegen FIR mit demselben Kern: 5 Hz Tiefpass bei 100 Hz
+constexpr auto kDecimatorLowPass = firLowPass<61>(100.0f, 5.0f);
+// BIQUAD: Butterworth 4. Ordnung (2 Sektionen) bei derselben Grenzfrequenz, 8. Ordnung (4 Sektionen)
+constexpr auto kButterworth4 = biquadButterworthLowPass<2>(100.0f, 5.0f);
+constexpr auto kButterworth8 = biquadButterworthLowPass<4>(100.0f, 5.0f);
+
+float g_madThreshold = 0.0f;
+const float kHampelThreshold = 3.0f;
+
+const size_t kChannelCounts[] = {1, 6, 18, 64, 1024};
+
+FilterConfig makeConfig(const Scenario& s) {
+  FilterConfig c = {};
+  c.type = s.type;
+  c.length = s.length;
+  c.coeffs = s.coeffs;
+  c.numCoeffs = s.numCoeffs;
+  c.normalFreqHz = kSampleRateHz;
+  c.maxDecayTimeMs = 10000;
+  c.warmUpTimeMs = 0;
+  c.thresholdPercent = 0.0f; // Jedes Sample wird gefiltert
+  c.deadTimeUs = 0.0f;
+  c.mode = VALUE_MODE;
+  c.madThreshold = s.madThreshold > 0.0f ? s.madThreshold : g_madThreshold;
+  c.decimation = s.decimation;
+  c.cicStages = s.cicStages;
+  c.cicDecimation = s.cicDecimation;
+#if defined(USE_KALMAN)
+  c.Q = 0.01f;
+  c.R = 0.1f;
+  c.initialState = 0.0f;
+#endif
+#if defined(USE_LMS)
+  c.mu = 0.01f;
+#endif
+#if defined(USE_RLS)
+  c.lambda = 0.99f;
+#endif
+  return c;
+}
+
+// Deterministisches Rauschen, vorab erzeugt, damit der RNG nicht mitgemessen wird
+std::vector<float> makeSignal(size_t n) {
+  std::vector<float> signal(n);
+  uint32_t state = 0x12345678u;
+  for (size_t i = 0; i < n; ++i) {
+    state = state * 1664525u + 1013904223u;
+    float noise = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+    signal[i] = 20.0f + 0.01f * static_cast<float>(i % 1000) + noise;
+  }
+  return signal;
+}
+
+#if defined(DAF_ENABLE_STATS)
+FilterStats g_stats;
+bool g_haveStats = false;
+
+void captureStats(const DynamicAdaptiveFilterV2& filter) { g_haveStats = filter.getStats(0, g_stats); }
+#endif
+template <typename Filter>
+void captureStats(const Filter&) {}
+
+double percentile(std::vector<double>& sorted, double p) {
+  if (sorted.empty()) return 0.0;
+  size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+template <typename Filter>
+Result run(const Scenario& s, size_t iters, const std::vector<float>& signal, bool raw) {
+  typedef std::chrono::steady_clock Clock;
+
+  std::vector<FilterConfig> configs(s.channels, makeConfig(s));
+  Filter filter(configs);
+  HostClock::useManual(1000000ULL);
+  filter.begin();
+
+  SensorData data;
+  data.values.assign(s.channels, 0.0f);
+  data.sensorId = "BENCH";
+
+  std::vector<double> latencies;
+  latencies.reserve(iters);
+
+  size_t warmup = std::min<size_t>(iters / 10 + 1, 1000);
+  size_t pos = 0;
+  for (size_t it = 0; it < warmup + iters; ++it) {
+    HostClock::advanceMillis(kIntervalMs);
+    data.timestamp = millis();
+    for (size_t c = 0; c < s.channels; ++c) {
+      data.values[c] = signal[(pos + c * 7) % signal.size()];
+    }
+    pos = (pos + 1) % signal.size();
+
+    bool measure = it >= warmup;
+    if (measure) g_countAllocs = true;
+    Clock::time_point t0 = Clock::now();
+    if (raw) {
+      filter.pushSamples(data.values.data(), s.channels, data.timestamp);
+    } else {
+      filter.pushSensorData(data);
+    }
+    Clock::time_point t1 = Clock::now();
+    g_countAllocs = false;
+    if (measure) {
+      latencies.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+  }
+  size_t pushAllocs = g_allocCount;
+  g_allocCount = 0;
+  captureStats(filter);
+
+  double total = 0.0;
+  for (double l : latencies) total += l;
+
+  // Lesepfad separat messen: getFilteredValues() bzw. mit --raw copyFilteredValues()
+  size_t getIters = std::max<size_t>(iters / 4, 1);
+  std::vector<float> copyBuffer(s.channels);
+  volatile float sink = 0.0f;
+  g_countAllocs = true;
+  Clock::time_point g0 = Clock::now();
+  for (size_t it = 0; it < getIters; ++it) {
+    if (raw) {
+      filter.copyFilteredValues(copyBuffer.data(), copyBuffer.size());
+      sink = sink + copyBuffer[0];
+    } else {
+      std::vector<float> out = filter.getFilteredValues();
+      sink = sink + out[0];
+    }
+  }
+  Clock::time_point g1 = Clock::now();
+  g_countAllocs = false;
+  size_t getAllocs = g_allocCount;
+  g_allocCount = 0;
+
+  std::sort(latencies.begin(), latencies.end());
+  double samples = static_cast<double>(iters) * static_cast<double>(s.channels);
+
+  Result r;
+  r.nsPerSample = total / samples;
+  r.p50 = percentile(latencies, 0.50);
+  r.p90 = percentile(latencies, 0.90);
+  r.p99 = percentile(latencies, 0.99);
+  r.maxNs = latencies.empty() ? 0.0 : latencies.back();
+  r.samplesPerSec = total > 0.0 ? samples * 1e9 / total : 0.0;
+  r.allocsPerSample = static_cast<double>(pushAllocs) / samples;
+  r.getNsPerCall = std::chrono::duration<double, std::nano>(g1 - g0).count() / static_cast<double>(getIters);
+  r.getAllocsPerCall = static_cast<double>(getAllocs) / static_cast<double>(getIters);
+  return r;
+}
+
+std::vector<Scenario> buildScenarios() {
+  std::vector<Scenario> list;
+  for (size_t ch : kChannelCounts) {
+    const int emaLengths[] = {5, 10, 50};
+    for (int len : emaLengths) {
+      list.push_back({"EMA", EMA, len, nullptr, 0, ch});
+    }
+    list.push_back({"HAMPEL+EMA", EMA, 5, nullptr, 0, ch, 0, 0, 0, kHampelThreshold});
+    const int smaLengths[] = {5, 10, 50, 600};
+    for (int len : smaLengths) {
+      list.push_back({"SMA", SMA, len, nullptr, 0, ch});
+    }
+    for (const FirTable& t : kFirTables) {
+      list.push_back({std::string("FIR/") + t.name, FIR, 0, t.coeffs, t.numCoeffs, ch});
+    }
+    const float* lp = kDecimatorLowPass.data();
+    const int lpTaps = static_cast<int>(kDecimatorLowPass.size());
+    list.push_back({"FIR/lowpass61", FIR, 0, lp, lpTaps, ch});
+    list.push_back({"DECIMATE/lowpass61/10", DECIMATE, 0, lp, lpTaps, ch, 10, 0, 1});
+    list.push_back({"DECIMATE/cic3/5+lowpass61/2", DECIMATE, 0, lp, lpTaps, ch, 2, 3, 5});
+    list.push_back({"BIQUAD/butterworth4", BIQUAD, 0, kButterworth4.data(), static_cast<int>(kButterworth4.size()), ch});
+    list.push_back({"BIQUAD/butterworth8", BIQUAD, 0, kButterworth8.data(), static_cast<int>(kButterworth8.size()), ch});
+#if defined(USE_KALMAN)
+    list.push_back({"KALMAN", KALMAN, 0, nullptr, 0, ch});
+#endif
+#if defined(USE_LMS)
+    const int lmsLengths[] = {2, MAX_FILTER_LENGTH};
+    for (int len : lmsLengths) {
+      list.push_back({"LMS", LMS, len, nullptr, 0, ch});
+    }
+#endif
+#if defined(USE_RLS)
+    const int rlsLengths[] = {2, MAX_FILTER_LENGTH};
+    for (int len : rlsLengths) {
+      list.push_back({"RLS", RLS, len, nullptr, 0, ch});
+    }
+#endif
+  }
+  return list;
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t iters = 20000;
+  bool csv = false;
+  bool raw = false;
+  bool bank = false;
+  std::string filterText;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+      iters = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filterText = argv[++i];
+    } else if (std::strcmp(argv[i], "--csv") == 0) {
+      csv = true;
+    } else if (std::strcmp(argv[i], "--raw") == 0) {
+      raw = true;
+    } else if (std::strcmp(argv[i], "--mad") == 0 && i + 1 < argc) {
+      g_madThreshold = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--bank") == 0) {
+      bank = true;
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--iters N] [--filter TEXT] [--csv] [--raw] [--bank] [--mad X]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (iters == 0) iters = 1;
+
+  std::vector<float> signal = makeSignal(4096);
+
+  if (csv) {
+    std::printf("scenario,channels,length,ns_per_sample,p50_ns,p90_ns,p99_ns,max_ns,samples_per_sec,"
+                "allocs_per_sample,get_ns_per_call,get_allocs_per_call\n");
+  } else {
+    std::printf("%-36s %4s %5s %10s %9s %9s %9s %10s %12s %10s %10s %10s\n",
+                "scenario", "ch", "len", "ns/sample", "p50 ns", "p90 ns", "p99 ns", "max ns",
+                "samples/s", "alloc/smp", "get ns", "get alloc");
+  }
+
+  for (const Scenario& s : buildScenarios()) {
+    if (!filterText.empty() && s.name.find(filterText) == std::string::npos) continue;
+    Result r = bank ? run<DynamicAdaptiveFilterBank>(s, iters, signal, raw)
+                    : run<DynamicAdaptiveFilterV2>(s, iters, signal, raw);
+    int len = s.type == FIR || s.type == DECIMATE || s.type == BIQUAD ? s.numCoeffs : s.length;
+    if (csv) {
+      std::printf("%s,%zu,%d,%.2f,%.0f,%.0f,%.0f,%.0f,%.0f,%.4f,%.1f,%.2f\n",
+                  s.name.c_str(), s.channels, len, r.nsPerSample, r.p50, r.p90, r.p99, r.maxNs,
+                  r.samplesPerSec, r.allocsPerSample, r.getNsPerCall, r.getAllocsPerCall);
+    } else {
+      std::printf("%-36s %4zu %5d %10.2f %9.0f %9.0f %9.0f %10.0f %12.0f %10.4f %10.1f %10.2f\n",
+                  s.name.c_str(), s.channels, len, r.nsPerSample, r.p50, r.p90, r.p99, r.maxNs,
+                  r.samplesPerSec, r.allocsPerSample, r.getNsPerCall, r.getAllocsPerCall);
+    }
+#if defined(DAF_ENABLE_STATS)
+    if (!csv && g_haveStats) {
+      const FilterStats& st = g_stats;
+      std::printf("    ch0: ok %u rate %u thr %u out %u dead %u | Zyklen last %u mean %u max %u | log2:",
+                  st.samples[STATS_ACCEPTED], st.samples[STATS_RATE_LIMITED], st.samples[STATS_BELOW_THRESHOLD],
+                  st.samples[STATS_OUTLIER], st.samples[STATS_DEAD_TIME], st.lastCycles, st.meanCycles, st.maxCycles);
+      for (size_t k = 0; k < STATS_HISTOGRAM_BUCKETS; ++k) {
+        if (st.histogram[k] > 0) std::printf(" %zu:%u", k, st.histogram[k]);
+      }
+      std::printf("\n");
+      g_haveStats = false;
+    }
+#endif
+  }
+  return 0;
+}
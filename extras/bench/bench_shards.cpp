@@ -0,0 +1,197 @@
+// Skalierung der ShardedFilterBank von 1 bis N Workern.
+//
+// Gateway-Szenario: --channels Kanäle, reihum mit den Profilen aus
+// params/params_sensors.h (BME688, SHT45, GPS NEO-M10, MPU-6050, SCD30)
+// belegt. Alle Knoten melden mit 10 Hz, der Anteil --hot der Kanäle
+// (zusammenhängend ab Kanal 0, also in wenigen Shards) mit 100 Hz.
+// thresholdPercent ist 0, damit jedes Sample gefiltert wird.
+//
+// Pro Frame (100 ms Signalzeit) werden alle Samples eingereiht und danach
+// einmal process() aufgerufen. Gemessen wird die Wandzeit für Einreihen +
+// process() sowie process() allein, je Worker-Anzahl; Referenz ist eine
+// einzelne DynamicAdaptiveFilterV2-Instanz über alle Kanäle. Die Ausgaben
+// müssen bitgleich zur Referenz sein (sonst Exit-Code 1).
+//
+// Aufruf: daf_bench_shards [--channels N] [--frames N] [--hot X] [--workers N] [--shards N]
+
+#include "ShardedFilterBank.h"
+#include "params/params_sensors.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const unsigned long kFrameMs = 100;
+const unsigned long kHotIntervalMs = 10;
+const size_t kHotSteps = kFrameMs / kHotIntervalMs;
+
+struct Load {
+  std::vector<FilterConfig> configs;
+  size_t hot;    // Kanäle 0 .. hot - 1 mit 100 Hz
+  size_t frames;
+};
+
+std::vector<FilterConfig> makeConfigs(size_t channels, size_t hot) {
+  const TableRef<FilterConfig> profiles[] = {
+    {filter_bme688.data(), filter_bme688.size()}, {filter_sht45.data(), filter_sht45.size()},
+    {filter_gps_neo_m10.data(), filter_gps_neo_m10.size()}, {filter_mpu6050.data(), filter_mpu6050.size()},
+    {filter_scd30.data(), filter_scd30.size()},
+  };
+  std::vector<FilterConfig> configs;
+  size_t p = 0;
+  while (configs.size() < channels) {
+    const TableRef<FilterConfig>& profile = profiles[p++ % (sizeof(profiles) / sizeof(profiles[0]))];
+    for (size_t i = 0; i < profile.size() && configs.size() < channels; ++i) {
+      FilterConfig config = profile[i];
+      config.normalFreqHz = configs.size() < hot ? 1000.0f / kHotIntervalMs : 1000.0f / kFrameMs;
+      config.thresholdPercent = 0.0f;
+      config.warmUpTimeMs = 0;
+      configs.push_back(config);
+    }
+  }
+  return configs;
+}
+
+// Messwert eines Kanals zum Zeitpunkt t (Offset je Kanal, langsame Welle + Rauschen)
+float sampleValue(size_t channel, unsigned long t) {
+  uint32_t h = static_cast<uint32_t>(channel * 2654435761u) ^ static_cast<uint32_t>(t * 40503u);
+  h ^= h >> 15;
+  h *= 2246822519u;
+  h ^= h >> 13;
+  float noise = static_cast<float>(h & 0xFFFF) / 65536.0f - 0.5f;
+  return 20.0f + static_cast<float>(channel % 97) + 2.0f * std::sin(0.001f * static_cast<float>(t) + channel) + noise;
+}
+
+// Schreibt alle Samples eines Frames über push(values, count, timestamp, firstChannel)
+template <typename Push>
+void pushFrame(const Load& load, unsigned long frameStart, std::vector<float>& row, Push push) {
+  size_t channels = load.configs.size();
+  for (size_t step = 0; step < kHotSteps; ++step) {
+    unsigned long t = frameStart + step * kHotIntervalMs;
+    if (step == 0) {
+      for (size_t c = 0; c < channels; ++c) row[c] = sampleValue(c, t);
+      push(row.data(), channels, t, 0);
+    } else if (load.hot > 0) {
+      for (size_t c = 0; c < load.hot; ++c) row[c] = sampleValue(c, t);
+      push(row.data(), load.hot, t, 0);
+    }
+  }
+}
+
+size_t samplesPerFrame(const Load& load) {
+  return load.configs.size() + (kHotSteps - 1) * load.hot;
+}
+
+double runSerial(const Load& load, std::vector<float>& outputs) {
+  HostClock::useManual(1000);
+  DynamicAdaptiveFilterV2 filter(load.configs);
+  filter.begin();
+  std::vector<float> row(load.configs.size());
+  Clock::time_point t0 = Clock::now();
+  for (size_t f = 0; f < load.frames; ++f) {
+    pushFrame(load, 1000 + (f + 1) * kFrameMs, row, [&](const float* v, size_t n, unsigned long t, size_t first) {
+      filter.pushSamples(v, n, t, first);
+    });
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+  outputs.assign(filter.filteredValues(), filter.filteredValues() + filter.channelCount());
+  return seconds;
+}
+
+struct ShardRun {
+  double total;   // Einreihen + process()
+  double process; // process() allein
+  bool complete;  // Keine Queue voll, alle Einträge verarbeitet
+};
+
+ShardRun runSharded(const Load& load, size_t workers, size_t shards, std::vector<float>& outputs) {
+  HostClock::useManual(1000);
+  ShardedFilterBank bank(load.configs, workers, shards);
+  bank.begin();
+  std::vector<float> row(load.configs.size());
+  ShardRun run = {0.0, 0.0, true};
+  size_t expected = samplesPerFrame(load);
+  Clock::time_point t0 = Clock::now();
+  for (size_t f = 0; f < load.frames; ++f) {
+    pushFrame(load, 1000 + (f + 1) * kFrameMs, row, [&](const float* v, size_t n, unsigned long t, size_t first) {
+      run.complete = bank.pushSamples(v, n, t, first) && run.complete;
+    });
+    Clock::time_point p0 = Clock::now();
+    run.complete = bank.process() == expected && run.complete;
+    run.process += std::chrono::duration<double>(Clock::now() - p0).count();
+  }
+  run.total = std::chrono::duration<double>(Clock::now() - t0).count();
+  outputs.assign(bank.filteredValues(), bank.filteredValues() + bank.channelCount());
+  return run;
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t channels = 4096;
+  size_t frames = 200;
+  double hotFraction = 0.05;
+  size_t maxWorkers = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+  size_t shards = 64;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--channels") == 0 && i + 1 < argc) {
+      channels = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      frames = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--hot") == 0 && i + 1 < argc) {
+      hotFraction = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+      maxWorkers = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+      shards = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--channels N] [--frames N] [--hot X] [--workers N] [--shards N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (channels == 0) channels = 1;
+  if (frames == 0) frames = 1;
+  if (maxWorkers == 0) maxWorkers = 1;
+  if (hotFraction < 0.0) hotFraction = 0.0;
+  if (hotFraction > 1.0) hotFraction = 1.0;
+
+  Load load;
+  load.hot = static_cast<size_t>(hotFraction * static_cast<double>(channels));
+  load.configs = makeConfigs(channels, load.hot);
+  load.frames = frames;
+  double samples = static_cast<double>(samplesPerFrame(load) * frames);
+
+  std::vector<float> reference;
+  double serial = runSerial(load, reference);
+  std::printf("%zu Kanäle (%zu mit 100 Hz), %zu Frames, %.0f Samples, %zu Shards, %u Kerne\n\n", channels, load.hot, frames,
+              samples, shards, std::thread::hardware_concurrency());
+  std::printf("%-12s %12s %12s %12s %10s %10s\n", "", "Mio Samples/s", "ns/Sample", "process ns", "Speedup", "Ausgabe");
+  std::printf("%-12s %12.2f %12.1f %12s %10s %10s\n", "seriell", samples / serial / 1e6, serial / samples * 1e9, "-", "-", "-");
+
+  bool ok = true;
+  double base = 0.0;
+  std::vector<size_t> workerCounts;
+  for (size_t w = 1; w < maxWorkers; w *= 2) workerCounts.push_back(w);
+  workerCounts.push_back(maxWorkers);
+  for (size_t k = 0; k < workerCounts.size(); ++k) {
+    size_t workers = workerCounts[k];
+    std::vector<float> outputs;
+    ShardRun run = runSharded(load, workers, shards, outputs);
+    bool same = run.complete && outputs.size() == reference.size() &&
+                std::memcmp(outputs.data(), reference.data(), reference.size() * sizeof(float)) == 0;
+    ok = ok && same;
+    if (workers == 1) base = run.process;
+    char label[32];
+    std::snprintf(label, sizeof(label), "%zu Worker", workers);
+    std::printf("%-12s %12.2f %12.1f %12.1f %10.2f %10s\n", label, samples / run.total / 1e6, run.total / samples * 1e9,
+                run.process / samples * 1e9, base / run.process, same ? "bitgleich" : "FEHLER");
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+// Stresstest der lock-freien Eingangsstufe (filter/IngestQueue.h, FilterIngest.h).
+//
+// Produzenten-Threads schreiben so schnell wie möglich, ein Konsument liest
+// parallel. Jeder Eintrag trägt Produzent (channel) und laufende Nummer
+// (timestamp); value ist aus derselben Nummer abgeleitet. Geprüft wird:
+//   verloren    jede Nummer je Produzent kommt genau einmal und in Reihenfolge an
+//   zerrissen   value passt zu timestamp (halb geschriebene Einträge fallen auf)
+//   Pulse       Summe aller onPulse()-Aufrufe == getPulseCount() im Filter
+// Produzenten nutzen abwechselnd push() und pushBatch(). Bei voller Queue
+// wiederholt der Produzent; dropped zählt diese Fehlversuche.
+// Exit-Code 1 bei Fehler.
+//
+// Aufruf: daf_stress_ingest [--events N] [--producers N]
+
+#include "FilterIngest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const size_t kQueueCapacity = 1024;
+
+float expectedValue(uint32_t seq) {
+  return static_cast<float>(seq & 0xFFFFFF) * 0.25f;
+}
+
+IngestEvent makeEvent(size_t producer, uint32_t seq) {
+  IngestEvent event = {seq, expectedValue(seq), static_cast<uint16_t>(producer), INGEST_SAMPLE};
+  return event;
+}
+
+// Prüft Reihenfolge und Vollständigkeit je Produzent
+struct Checker {
+  std::vector<uint32_t> next;
+  size_t lost;
+  size_t torn;
+  size_t received;
+
+  explicit Checker(size_t producers) : next(producers, 0), lost(0), torn(0), received(0) {}
+
+  void check(const IngestEvent& event) {
+    received++;
+    if (event.channel >= next.size() || event.kind != INGEST_SAMPLE || event.value != expectedValue(event.timestamp)) {
+      torn++;
+      return;
+    }
+    if (event.timestamp != next[event.channel]) lost++;
+    next[event.channel] = event.timestamp + 1;
+  }
+};
+
+template <typename Queue>
+bool runQueue(const char* name, size_t producers, size_t eventsPerProducer) {
+  std::unique_ptr<Queue> q(new Queue());
+  Checker checker(producers);
+
+  Clock::time_point t0 = Clock::now();
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p]() {
+      // Abwechselnd Einzel-push() und pushBatch() mit 5 Einträgen
+      for (uint32_t seq = 0; seq < eventsPerProducer;) {
+        if (seq % 2 == 0 && seq + 5 <= eventsPerProducer) {
+          IngestEvent batch[5];
+          for (uint32_t i = 0; i < 5; ++i) batch[i] = makeEvent(p, seq + i);
+          while (!q->pushBatch(batch, 5)) std::this_thread::yield();
+          seq += 5;
+        } else {
+          IngestEvent event = makeEvent(p, seq);
+          while (!q->push(event)) std::this_thread::yield();
+          seq++;
+        }
+      }
+    });
+  }
+  size_t total = producers * eventsPerProducer;
+  IngestEvent batch[INGEST_DRAIN_BATCH];
+  while (checker.received < total) {
+    size_t n = q->popBatch(batch, INGEST_DRAIN_BATCH);
+    for (size_t i = 0; i < n; ++i) checker.check(batch[i]);
+    if (n == 0) std::this_thread::yield();
+  }
+  for (size_t p = 0; p < producers; ++p) threads[p].join();
+  double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+  for (size_t p = 0; p < producers; ++p) {
+    if (checker.next[p] != eventsPerProducer) checker.lost++;
+  }
+  bool ok = checker.lost == 0 && checker.torn == 0;
+  std::printf("%-6s %2zu Produzenten %10zu Einträge %8.1f Mio/s  dropped %8u  verloren %zu  zerrissen %zu  %s\n",
+              name, producers, checker.received, static_cast<double>(checker.received) / seconds / 1e6,
+              q->dropped(), checker.lost, checker.torn, ok ? "OK" : "FEHLER");
+  return ok;
+}
+
+// Pulse aus mehreren Threads, Filter-Task übernimmt sie parallel per drain()
+bool runPulses(size_t producers, size_t pulsesPerProducer) {
+  FilterConfig config = {EMA, 1, nullptr, 0, 1.0f, 60000, 60000, 0.0f, 10.0f, COUNT_MODE, 0.0f};
+  std::vector<FilterConfig> configs(producers, config);
+  HostClock::useManual(1000);
+  DynamicAdaptiveFilterV2 filter(configs);
+  filter.begin();
+  FilterIngest<MpscQueue<IngestEvent, kQueueCapacity> > ingest(filter);
+
+  Clock::time_point t0 = Clock::now();
+  std::atomic<size_t> finished(0);
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p]() {
+      for (size_t i = 0; i < pulsesPerProducer; ++i) {
+        if ((i & 7) == 7) ingest.onPulses(p, 2); else ingest.onPulse(p);
+      }
+      finished.fetch_add(1);
+    });
+  }
+  size_t expectedPerChannel = pulsesPerProducer + pulsesPerProducer / 8;
+  while (finished.load() < producers) ingest.drain();
+  for (size_t p = 0; p < producers; ++p) threads[p].join();
+  ingest.drain();
+  double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+  size_t lost = 0;
+  for (size_t p = 0; p < producers; ++p) {
+    if (filter.getPulseCount(static_cast<int>(p)) != expectedPerChannel) lost++;
+  }
+  std::printf("%-6s %2zu Produzenten %10zu Pulse    %8.1f Mio/s  Kanäle mit falscher Summe %zu  %s\n",
+              "Pulse", producers, producers * expectedPerChannel,
+              static_cast<double>(producers * expectedPerChannel) / seconds / 1e6, lost, lost == 0 ? "OK" : "FEHLER");
+  return lost == 0;
+}
+
+// Samples über FilterIngest bis in den Filter: jeder angenommene Eintrag wird verarbeitet
+bool runIngest(size_t producers, size_t eventsPerProducer) {
+  FilterConfig config = {EMA, 1, nullptr, 0, 1000.0f, 5000, 0, 0.0f, 0.0f, VALUE_MODE, 0.0f};
+  std::vector<FilterConfig> configs(producers, config);
+  HostClock::useManual(1000);
+  DynamicAdaptiveFilterV2 filter(configs);
+  filter.begin();
+  std::unique_ptr<FilterIngest<MpscQueue<IngestEvent, kQueueCapacity> > > ingest(
+      new FilterIngest<MpscQueue<IngestEvent, kQueueCapacity> >(filter));
+
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p]() {
+      for (uint32_t seq = 1; seq <= eventsPerProducer; ++seq) {
+        while (!ingest->pushSample(p, expectedValue(seq), seq)) std::this_thread::yield();
+      }
+    });
+  }
+  size_t total = producers * eventsPerProducer;
+  size_t drained = 0;
+  while (drained < total) drained += ingest->drain();
+  for (size_t p = 0; p < producers; ++p) threads[p].join();
+
+  // Je Kanal gilt der letzte Wert (EMA mit Länge 1 übernimmt jedes Sample)
+  size_t wrong = 0;
+  for (size_t p = 0; p < producers; ++p) {
+    if (filter.getFilteredValue(static_cast<int>(p)) != expectedValue(static_cast<uint32_t>(eventsPerProducer))) wrong++;
+  }
+  bool ok = drained == total && wrong == 0;
+  std::printf("%-6s %2zu Produzenten %10zu Samples  dropped %8u  Kanäle mit falschem Endwert %zu  %s\n",
+              "Filter", producers, drained, ingest->dropped(), wrong, ok ? "OK" : "FEHLER");
+  return ok;
+}
+
+}
+
+int main(int argc, char** argv) {
+  size_t events = 4000000;
+  size_t producers = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 2;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+      events = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) {
+      producers = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      std::fprintf(stderr, "Aufruf: %s [--events N] [--producers N]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (producers < 2) producers = 2;
+  if (producers > 8) producers = 8;
+  if (events < producers) events = producers;
+
+  bool ok = true;
+  ok = runQueue<SpscQueue<IngestEvent, kQueueCapacity> >("SPSC", 1, events) && ok;
+  ok = runQueue<MpscQueue<IngestEvent, kQueueCapacity> >("MPSC", producers, events / producers) && ok;
+  ok = runPulses(producers, events / producers) && ok;
+  ok = runIngest(producers, events / producers / 4) && ok;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#include "Arduino.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+uint64_t steadyMicros() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - start).count());
+}
+
+uint64_t manualUs = 0;
+
+uint64_t manualMicros() {
+  return manualUs;
+}
+
+HostClock::MicrosSource clockSource = steadyMicros;
+
+}
+
+namespace HostClock {
+
+void useSteadyClock() { clockSource = steadyMicros; }
+void useSource(MicrosSource source) { clockSource = source ? source : steadyMicros; }
+void useManual(uint64_t startUs) { manualUs = startUs; clockSource = manualMicros; }
+void setMicros(uint64_t us) { manualUs = us; }
+void setMillis(uint64_t ms) { manualUs = ms * 1000ULL; }
+void advanceMicros(uint64_t us) { manualUs += us; }
+void advanceMillis(uint64_t ms) { manualUs += ms * 1000ULL; }
+uint64_t nowMicros() { return clockSource(); }
+
+}
+
+unsigned long millis() { return static_cast<unsigned long>(HostClock::nowMicros() / 1000ULL); }
+unsigned long micros() { return static_cast<unsigned long>(HostClock::nowMicros()); }
+
+void delay(unsigned long ms) {
+  // 64 Bit: ms * 1000 passt ab ~71 min nicht mehr in unsigned int
+  uint64_t us = static_cast<uint64_t>(ms) * 1000ULL;
+  if (clockSource == manualMicros) {
+    manualUs += us;
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  }
+}
+
+void delayMicroseconds(unsigned int us) {
+  // Manuelle Uhr: Zeit vorspulen statt schlafen
+  if (clockSource == manualMicros) {
+    manualUs += us;
+  } else {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  }
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return LOW; }
+int analogRead(uint8_t) { return 0; }
+
+String::String(float v, unsigned int decimals) : String(static_cast<double>(v), decimals) {}
+
+String::String(double v, unsigned int decimals) {
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimals), v);
+  _s = buf;
+}
@@ -0,0 +1,88 @@
+#ifndef DAF_HOST_ARDUINO_H
+#define DAF_HOST_ARDUINO_H
+
+// Minimaler Arduino-Shim für Host-Builds (Linux/macOS).
+// Stellt nur das bereit, was die Bibliothek selbst benutzt: Zeitbasis,
+// GPIO-Stubs, String und die Arduino-Hilfsfunktionen min/max/abs/constrain.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define LED_BUILTIN 2
+
+#define IRAM_ATTR
+
+using std::abs;
+using std::max;
+using std::min;
+
+template <typename T, typename L, typename H>
+inline T constrain(T x, L low, H high) {
+  return x < low ? low : (x > high ? high : x);
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// Injizierbare Uhr: Standard ist std::chrono::steady_clock ab Programmstart.
+// Benchmarks und Replay-Tools schalten auf eine manuelle Uhr um oder
+// hängen eine eigene Mikrosekundenquelle ein.
+namespace HostClock {
+  typedef uint64_t (*MicrosSource)();
+
+  void useSteadyClock();
+  void useSource(MicrosSource source);
+  void useManual(uint64_t startUs = 0);
+  void setMicros(uint64_t us);
+  void setMillis(uint64_t ms);
+  void advanceMicros(uint64_t us);
+  void advanceMillis(uint64_t ms);
+  uint64_t nowMicros();
+}
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") {}
+  String(const std::string& s) : _s(s) {}
+  String(char c) : _s(1, c) {}
+  String(int v) : _s(std::to_string(v)) {}
+  String(unsigned int v) : _s(std::to_string(v)) {}
+  String(long v) : _s(std::to_string(v)) {}
+  String(unsigned long v) : _s(std::to_string(v)) {}
+  String(float v, unsigned int decimals = 2);
+  String(double v, unsigned int decimals = 2);
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return static_cast<unsigned int>(_s.size()); }
+  bool isEmpty() const { return _s.empty(); }
+  char operator[](unsigned int i) const { return _s[i]; }
+
+  bool equals(const String& o) const { return _s == o._s; }
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator!=(const String& o) const { return _s != o._s; }
+  bool operator<(const String& o) const { return _s < o._s; }
+
+  String& operator+=(const String& o) { _s += o._s; return *this; }
+  friend String operator+(String a, const String& b) { a += b; return a; }
+
+private:
+  std::string _s;
+};
+
+#endif
@@ -0,0 +1,80 @@
+// DECIMATE auf quantisiertem Eingang (params/params_analog.h, filter_analog_fast).
+//
+// Ein ADC liefert round(500.3 + Rauschen) mit 1 kHz, Rauschen unter bzw. um
+// 1 LSB. Der Mittelwert der dezimierten Ausgänge muss dem Mittelwert des
+// quantisierten Eingangs folgen (bei sigma = 0.5 LSB also dem wahren Wert):
+// die Überabtastung gewinnt Auflösung, solange keine Stufe ersetzt wird.
+// Geprüft wird filter_analog_fast (ohne Hampel-Vorstufe) und dieselbe
+// Konfiguration mit madThreshold 3.0, bei der MAD = 0 nichts ersetzen darf.
+// Exit-Code 1 bei Fehler.
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "params/params_analog.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+const float kTrueValue = 500.3f;
+const unsigned long kSettleMs = 2000;
+const unsigned long kRunMs = 30000;
+const double kTolerance = 0.02; // LSB
+int g_failures = 0;
+
+struct Means {
+  double input;
+  double output;
+};
+
+Means run(const FilterConfig& config, float sigma) {
+  std::vector<FilterConfig> configs(1, config);
+  DynamicAdaptiveFilterV2 filter(configs);
+  HostClock::useManual(1000000ULL);
+  filter.begin();
+
+  std::mt19937 rng(1234);
+  std::normal_distribution<float> noise(0.0f, sigma);
+  unsigned long outputEveryMs = static_cast<unsigned long>(1000.0f / config.normalFreqHz) * config.decimation * config.cicDecimation;
+  double inputSum = 0.0, outputSum = 0.0;
+  size_t inputs = 0, outputs = 0;
+  for (unsigned long t = 1; t <= kRunMs; ++t) {
+    HostClock::advanceMillis(1);
+    float sample = std::round(kTrueValue + noise(rng));
+    filter.pushSamples(&sample, 1, millis());
+    if (t <= kSettleMs) continue;
+    inputSum += sample;
+    inputs++;
+    if (t % outputEveryMs == 0) {
+      outputSum += filter.getFilteredValue(0);
+      outputs++;
+    }
+  }
+  Means m = {inputSum / inputs, outputSum / outputs};
+  return m;
+}
+
+void check(const char* name, const FilterConfig& config, float sigma, double expected) {
+  Means m = run(config, sigma);
+  bool ok = std::fabs(m.output - expected) < kTolerance;
+  std::printf("%-24s sigma %.1f  Eingang %8.4f  Ausgang %8.4f  Soll %8.4f  %s\n", name, sigma, m.input, m.output, expected,
+              ok ? "ok" : "FEHLER");
+  if (!ok) g_failures++;
+}
+
+}
+
+int main() {
+  FilterConfig preset = filter_analog_fast[0];
+  FilterConfig hampel = preset;
+  hampel.madThreshold = 3.0f;
+
+  check("filter_analog_fast", preset, 0.5f, kTrueValue);
+  check("filter_analog_fast", preset, 0.2f, run(preset, 0.2f).input);
+  check("madThreshold 3.0", hampel, 0.5f, kTrueValue);
+  check("madThreshold 3.0", hampel, 0.2f, run(hampel, 0.2f).input);
+
+  return g_failures == 0 ? 0 : 1;
+}
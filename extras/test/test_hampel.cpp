@@ -0,0 +1,91 @@
+// Hampel-Vorstufe bei MAD = 0 (filter/FilterMath.h, filterIsOutlier()).
+//
+// Geprüft wird:
+//   Stufe     konstantes Fenster, dann +1: kein Ausreißer, der Sprung kommt durch
+//   Spike     Fenster mit Streuung, dann ein Spike: wird weiterhin verworfen
+// jeweils direkt an filterIsOutlier(), an DynamicAdaptiveFilterV2 und an
+// DynamicAdaptiveFilterBank (EMA der Länge 1, Ausgang = letztes übernommenes Sample).
+// Exit-Code 1 bei Fehler.
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "DynamicAdaptiveFilterBank.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const unsigned long kIntervalMs = 10;
+int g_failures = 0;
+
+void check(bool ok, const char* what) {
+  std::printf("%-52s %s\n", what, ok ? "ok" : "FEHLER");
+  if (!ok) g_failures++;
+}
+
+FilterConfig makeConfig() {
+  FilterConfig c = {};
+  c.type = EMA;
+  c.length = 1;
+  c.normalFreqHz = 1000.0f / kIntervalMs;
+  c.maxDecayTimeMs = 10000;
+  c.warmUpTimeMs = 0;
+  c.thresholdPercent = 0.0f;
+  c.mode = VALUE_MODE;
+  c.madThreshold = 3.0f;
+#if defined(USE_KALMAN)
+  c.Q = 0.01f;
+  c.R = 0.1f;
+#endif
+  return c;
+}
+
+// Schiebt values nacheinander in Kanal 0 und liefert den gefilterten Wert danach
+template <typename Filter>
+float run(const std::vector<float>& values) {
+  std::vector<FilterConfig> configs(1, makeConfig());
+  Filter filter(configs);
+  HostClock::useManual(1000000ULL);
+  filter.begin();
+  for (float v : values) {
+    HostClock::advanceMillis(kIntervalMs);
+    filter.pushSamples(&v, 1, millis());
+  }
+  return filter.getFilteredValue(0);
+}
+
+std::vector<float> constantThen(float last) {
+  std::vector<float> values(MAD_WINDOW_LENGTH, 100.0f);
+  values.push_back(last);
+  return values;
+}
+
+std::vector<float> spreadThen(float last) {
+  std::vector<float> values;
+  for (int i = 0; i < MAD_WINDOW_LENGTH; ++i) values.push_back(i % 2 ? 101.0f : 99.0f);
+  values.push_back(last);
+  return values;
+}
+
+}
+
+int main() {
+  StreamingMAD window;
+  window.reset(MAD_WINDOW_LENGTH);
+  for (int i = 0; i < MAD_WINDOW_LENGTH; ++i) window.push(100.0f);
+  window.push(101.0f);
+  check(window.mad() == 0.0f, "Stufe: MAD des Fensters ist 0");
+  check(!filterIsOutlier(window, 3.0f, 101.0f), "Stufe: filterIsOutlier() meldet keinen Ausreißer");
+
+  window.reset(MAD_WINDOW_LENGTH);
+  std::vector<float> spread = spreadThen(150.0f);
+  for (float v : spread) window.push(v);
+  check(filterIsOutlier(window, 3.0f, 150.0f), "Spike: filterIsOutlier() meldet Ausreißer");
+
+  check(run<DynamicAdaptiveFilterV2>(constantThen(101.0f)) == 101.0f, "Stufe: V2 übernimmt +1");
+  check(run<DynamicAdaptiveFilterBank>(constantThen(101.0f)) == 101.0f, "Stufe: Bank übernimmt +1");
+  check(run<DynamicAdaptiveFilterV2>(spread) != 150.0f, "Spike: V2 verwirft den Spike");
+  check(run<DynamicAdaptiveFilterBank>(spread) != 150.0f, "Spike: Bank verwirft den Spike");
+
+  return g_failures == 0 ? 0 : 1;
+}
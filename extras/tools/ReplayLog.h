@@ -0,0 +1,239 @@
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+// Lesen und Schreiben aufgezeichneter Sensor-Logs für die Host-Werkzeuge
+// (daf_replay, daf_autotune).
+//
+//   CSV:  timestamp_ms,v0,v1,...  je Zeile; Kopfzeile und Leerzeilen werden übersprungen,
+//         die Kanalzahl ergibt sich aus der ersten Datenzeile.
+//   DAFL: Binär, Header {'D','A','F','L', uint16 version = 1, uint16 channels},
+//         danach Datensätze {uint32 timestamp_ms, float values[channels]} in
+//         Byte-Reihenfolge des Hosts. Endung .dafl, sonst CSV.
+//
+// Eingaben werden per mmap gelesen und nur sequenziell durchlaufen, Logs im
+// GB-Bereich liegen dadurch nie vollständig im Speicher.
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char kLogMagic[4] = {'D', 'A', 'F', 'L'};
+const uint16_t kLogVersion = 1;
+const size_t kLogHeaderSize = 8;
+const size_t kOutputBuffer = 1 << 20;
+
+inline bool endsWith(const std::string& s, const char* suffix) {
+  size_t n = std::strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+// Nur-Lese-Abbildung einer Datei, sequenziell gelesen
+class MappedFile {
+public:
+  explicit MappedFile(const std::string& path) : _data(nullptr), _size(0), _fd(-1) {
+    _fd = open(path.c_str(), O_RDONLY);
+    if (_fd < 0) return;
+    struct stat st;
+    if (fstat(_fd, &st) != 0 || st.st_size == 0) return;
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (p == MAP_FAILED) return;
+    madvise(p, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    _data = static_cast<const char*>(p);
+    _size = static_cast<size_t>(st.st_size);
+  }
+  ~MappedFile() {
+    if (_data != nullptr) munmap(const_cast<char*>(_data), _size);
+    if (_fd >= 0) close(_fd);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool opened() const { return _fd >= 0; }
+  const char* data() const { return _data; }
+  size_t size() const { return _size; }
+
+private:
+  const char* _data;
+  size_t _size;
+  int _fd;
+};
+
+struct ReadStats {
+  size_t records;
+  size_t skipped; // Zeilen mit falscher Feldzahl oder Zahlenformat
+};
+
+// Ruft record(timestamp, values) für jeden Datensatz auf; channels wird aus der Datei bestimmt
+template <typename Record>
+bool readCsv(const MappedFile& file, size_t& channels, ReadStats& stats, Record record) {
+  const char* p = file.data();
+  const char* end = p + file.size();
+  std::vector<float> values;
+  channels = 0;
+  while (p < end) {
+    const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    if (eol == nullptr) eol = end;
+    const char* line = p;
+    p = eol + 1;
+    const char* lineEnd = eol > line && eol[-1] == '\r' ? eol - 1 : eol;
+    if (lineEnd == line) continue;
+    if (!(*line >= '0' && *line <= '9')) {
+      if (stats.records == 0 && stats.skipped == 0) continue; // Kopfzeile
+      stats.skipped++;
+      continue;
+    }
+
+    uint32_t timestamp = 0;
+    std::from_chars_result r = std::from_chars(line, lineEnd, timestamp);
+    values.clear();
+    bool ok = r.ec == std::errc();
+    const char* q = r.ptr;
+    while (ok && q < lineEnd) {
+      if (*q != ',') {
+        ok = false;
+        break;
+      }
+      ++q;
+      while (q < lineEnd && *q == ' ') ++q;
+      float v = 0.0f;
+      r = std::from_chars(q, lineEnd, v);
+      ok = r.ec == std::errc();
+      values.push_back(v);
+      q = r.ptr;
+      while (q < lineEnd && *q == ' ') ++q;
+    }
+    if (ok && channels == 0) channels = values.size();
+    if (!ok || values.empty() || values.size() != channels) {
+      stats.skipped++;
+      continue;
+    }
+    record(timestamp, values.data());
+    stats.records++;
+  }
+  return channels > 0;
+}
+
+template <typename Record>
+bool readDafl(const MappedFile& file, size_t& channels, ReadStats& stats, Record record) {
+  if (file.size() < kLogHeaderSize || std::memcmp(file.data(), kLogMagic, 4) != 0) return false;
+  uint16_t version = 0;
+  uint16_t count = 0;
+  std::memcpy(&version, file.data() + 4, 2);
+  std::memcpy(&count, file.data() + 6, 2);
+  if (version != kLogVersion || count == 0) return false;
+  channels = count;
+  size_t recordSize = 4 + 4 * channels;
+  std::vector<float> values(channels);
+  const char* p = file.data() + kLogHeaderSize;
+  size_t n = (file.size() - kLogHeaderSize) / recordSize;
+  for (size_t i = 0; i < n; ++i, p += recordSize) {
+    uint32_t timestamp;
+    std::memcpy(&timestamp, p, 4);
+    std::memcpy(values.data(), p + 4, 4 * channels);
+    record(timestamp, values.data());
+  }
+  stats.records = n;
+  stats.skipped = (file.size() - kLogHeaderSize) % recordSize != 0 ? 1 : 0; // Abgeschnittener letzter Datensatz
+  return true;
+}
+
+template <typename Record>
+bool readLog(const std::string& path, size_t& channels, ReadStats& stats, Record record) {
+  MappedFile file(path);
+  if (!file.opened()) {
+    std::fprintf(stderr, "Kann %s nicht öffnen\n", path.c_str());
+    return false;
+  }
+  stats.records = 0;
+  stats.skipped = 0;
+  bool ok = endsWith(path, ".dafl") ? readDafl(file, channels, stats, record) : readCsv(file, channels, stats, record);
+  if (!ok) std::fprintf(stderr, "%s: kein gültiges Log\n", path.c_str());
+  return ok;
+}
+
+// Gepufferte Ausgabe als CSV oder DAFL
+class LogWriter {
+public:
+  LogWriter() : _file(nullptr), _binary(false), _headerDone(false) {}
+  ~LogWriter() { close(); }
+
+  bool open(const std::string& path) {
+    _binary = endsWith(path, ".dafl");
+    _file = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+    if (_file == nullptr) {
+      std::fprintf(stderr, "Kann %s nicht schreiben\n", path.c_str());
+      return false;
+    }
+    _buf.reserve(kOutputBuffer + 4096);
+    return true;
+  }
+
+  bool enabled() const { return _file != nullptr; }
+
+  void write(uint32_t timestamp, const float* values, size_t channels) {
+    if (!_headerDone) header(channels);
+    if (_binary) {
+      append(&timestamp, 4);
+      append(values, 4 * channels);
+    } else {
+      char text[32];
+      char* end = std::to_chars(text, text + sizeof(text), timestamp).ptr;
+      append(text, end - text);
+      for (size_t c = 0; c < channels; ++c) {
+        text[0] = ',';
+        end = std::to_chars(text + 1, text + sizeof(text), values[c]).ptr;
+        append(text, end - text);
+      }
+      append("\n", 1);
+    }
+    if (_buf.size() >= kOutputBuffer) flush();
+  }
+
+  void close() {
+    if (_file == nullptr) return;
+    flush();
+    if (_file != stdout) std::fclose(_file);
+    _file = nullptr;
+  }
+
+private:
+  std::FILE* _file;
+  bool _binary;
+  bool _headerDone;
+  std::vector<char> _buf;
+
+  void header(size_t channels) {
+    _headerDone = true;
+    if (_binary) {
+      uint16_t version = kLogVersion;
+      uint16_t count = static_cast<uint16_t>(channels);
+      append(kLogMagic, 4);
+      append(&version, 2);
+      append(&count, 2);
+    } else {
+      std::string line = "timestamp_ms";
+      for (size_t c = 0; c < channels; ++c) line += ",ch" + std::to_string(c);
+      line += "\n";
+      append(line.data(), line.size());
+    }
+  }
+
+  void append(const void* data, size_t n) {
+    const char* p = static_cast<const char*>(data);
+    _buf.insert(_buf.end(), p, p + n);
+  }
+
+  void flush() {
+    if (!_buf.empty()) std::fwrite(_buf.data(), 1, _buf.size(), _file);
+    _buf.clear();
+  }
+};
+
+#endif
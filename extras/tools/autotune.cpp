@@ -0,0 +1,464 @@
+// Parameter-Suche für FilterConfig auf Basis aufgezeichneter Logs.
+//
+// Für jeden Kanal des Logs (CSV oder DAFL, siehe ReplayLog.h) wird ein Raster
+// von Kandidaten erzeugt (Filtertyp, Länge bzw. FIR-Tabelle, Kalman Q/R,
+// thresholdPercent, normalFreqHz, maxDecayTimeMs, madThreshold) und jeder
+// Kandidat als einkanaliger DynamicAdaptiveFilterV2 über die komplette
+// Spalte abgespielt, verteilt auf alle Kerne. Kanäle sind im Filter
+// unabhängig, daher genügt die Suche je Kanal.
+//
+// Bewertung gegen eine nullphasige Referenz (zentrierter gleitender
+// Mittelwert über --ref-window Samples):
+//   Fehler  RMS(Ausgabe - Referenz) / RMS(Eingabe - Referenz): Rest-Rauschen inkl. Verzögerung
+//   Glätte  RMS(Δ Ausgabe) / RMS(Δ Eingabe)
+//   Lag     Verschiebung der Referenz (0 .. --max-lag Samples) mit kleinstem Fehler, in ms
+//   CPU     ns pro Sample im Replay
+// Score = Fehler + wS · Glätte + wL · Lag/s + wC · (ns/100), Gewichte per --weights E,S,L,C.
+// Der beste Kandidat je Kanal wird als FilterConfig-Initialisierer im Stil
+// von params/params_sensors.h ausgegeben, Tabellenname filter_NAME (--name,
+// ein vorhandenes Präfix filter_ wird nicht verdoppelt).
+//
+// Raster: --set KEY=v1,v2,... ersetzt die Standardwerte eines Schlüssels:
+//   type (EMA,SMA,FIR,KALMAN), length, fir (Tabellennamen aus FIR_coefficients.h),
+//   q, r, threshold, freq (Hz, "auto" = Median der Log-Abstände), decay (ms), mad
+// --random N bewertet statt des vollen Rasters N zufällig gezogene Kandidaten.
+//
+// Aufruf: daf_autotune [--set KEY=WERTE]... [--random N] [--seed S] [--channel N] [--threads N]
+//                      [--ref-window N] [--max-lag N] [--weights E,S,L,C] [--top N] [--name NAME] EINGABE
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "filter/FIR_coefficients.h"
+#include "ReplayLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct FirTable {
+  const char* name;
+  const float* coeffs;
+  int numCoeffs;
+};
+
+#define FIR_TABLE(t) { #t, t, static_cast<int>(sizeof(t) / sizeof(t[0])) }
+const FirTable kFirTables[] = {
+  FIR_TABLE(chebyshev_lowpass_order1), FIR_TABLE(chebyshev_lowpass_order2), FIR_TABLE(chebyshev_lowpass_order3),
+  FIR_TABLE(bessel_lowpass_order1), FIR_TABLE(bessel_lowpass_order2), FIR_TABLE(bessel_lowpass_order3),
+  FIR_TABLE(butterworth_lowpass_order1), FIR_TABLE(butterworth_lowpass_order2), FIR_TABLE(butterworth_lowpass_order3),
+  FIR_TABLE(notch_50hz),
+};
+#undef FIR_TABLE
+
+// Eine Spalte des Logs
+struct Series {
+  const std::vector<uint32_t>* timestamps;
+  std::vector<float> values;
+  std::vector<float> reference; // Zentrierter gleitender Mittelwert
+  double inputError;            // RMS(Eingabe - Referenz)
+  double inputRoughness;        // RMS(Δ Eingabe)
+  size_t first;                 // Erstes bewertetes Sample (Einschwingen ausgenommen)
+};
+
+struct Candidate {
+  FilterConfig config;
+  const char* firName;
+};
+
+struct Evaluation {
+  double score;
+  double error;
+  double smooth;
+  double lagMs;
+  double nsPerSample;
+  size_t candidate;
+};
+
+struct Weights {
+  double error, smooth, lag, cpu;
+};
+
+typedef std::map<std::string, std::vector<std::string> > Grid;
+
+std::vector<std::string> split(const std::string& text, char sep) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  while (start <= text.size()) {
+    size_t end = text.find(sep, start);
+    if (end == std::string::npos) end = text.size();
+    if (end > start) parts.push_back(text.substr(start, end - start));
+    start = end + 1;
+  }
+  return parts;
+}
+
+Grid defaultGrid() {
+  Grid grid;
+  grid["type"] = {"EMA", "SMA", "FIR", "KALMAN"};
+  grid["length"] = {"3", "5", "10", "20", "50"};
+  for (const FirTable& t : kFirTables) grid["fir"].push_back(t.name);
+  grid["q"] = {"0.001", "0.01", "0.1"};
+  grid["r"] = {"0.1", "1", "10"};
+  grid["threshold"] = {"0", "0.5", "1", "2"};
+  grid["freq"] = {"auto"};
+  grid["decay"] = {"3600000"};
+  grid["mad"] = {"0", "3"};
+  return grid;
+}
+
+std::vector<float> numbers(const std::vector<std::string>& values, float autoValue) {
+  std::vector<float> result;
+  for (const std::string& v : values) result.push_back(v == "auto" ? autoValue : static_cast<float>(std::atof(v.c_str())));
+  return result;
+}
+
+// Kreuzprodukt des Rasters; nur Kombinationen, die validateConfig() akzeptiert
+std::vector<Candidate> expand(const Grid& grid, float autoFreqHz) {
+  std::vector<Candidate> list;
+  std::vector<float> thresholds = numbers(grid.at("threshold"), 0.0f);
+  std::vector<float> freqs = numbers(grid.at("freq"), autoFreqHz);
+  std::vector<float> decays = numbers(grid.at("decay"), 3600000.0f);
+  std::vector<float> mads = numbers(grid.at("mad"), 0.0f);
+  std::vector<float> lengths = numbers(grid.at("length"), 10.0f);
+  std::vector<float> qs = numbers(grid.at("q"), 0.01f);
+  std::vector<float> rs = numbers(grid.at("r"), 1.0f);
+
+  for (const std::string& type : grid.at("type")) {
+    // Typabhängiger Teil: Länge, FIR-Tabelle oder Q/R
+    std::vector<Candidate> shapes;
+    Candidate base = {};
+    base.config.mode = VALUE_MODE;
+    if (type == "EMA" || type == "SMA") {
+      base.config.type = type == "EMA" ? EMA : SMA;
+      for (float length : lengths) {
+        base.config.length = static_cast<int>(length);
+        shapes.push_back(base);
+      }
+    } else if (type == "FIR") {
+      base.config.type = FIR;
+      for (const std::string& name : grid.at("fir")) {
+        for (const FirTable& t : kFirTables) {
+          if (name != t.name) continue;
+          base.config.coeffs = t.coeffs;
+          base.config.numCoeffs = t.numCoeffs;
+          base.firName = t.name;
+          shapes.push_back(base);
+        }
+      }
+    }
+#if defined(USE_KALMAN)
+    else if (type == "KALMAN") {
+      base.config.type = KALMAN;
+      for (float q : qs) {
+        for (float r : rs) {
+          base.config.Q = q;
+          base.config.R = r;
+          shapes.push_back(base);
+        }
+      }
+    }
+#endif
+    for (const Candidate& shape : shapes) {
+      for (float threshold : thresholds) {
+        for (float freq : freqs) {
+          for (float decay : decays) {
+            for (float mad : mads) {
+              Candidate c = shape;
+              c.config.thresholdPercent = threshold;
+              c.config.normalFreqHz = freq;
+              c.config.maxDecayTimeMs = static_cast<unsigned long>(decay);
+              c.config.warmUpTimeMs = 2000;
+              c.config.madThreshold = mad;
+              if (DynamicAdaptiveFilterV2::validateConfig(c.config)) list.push_back(c);
+            }
+          }
+        }
+      }
+    }
+  }
+  return list;
+}
+
+void prepareReference(Series& s, size_t window) {
+  size_t n = s.values.size();
+  window = std::max<size_t>(1, window | 1); // ungerade, zentriert
+  size_t half = window / 2;
+  std::vector<double> prefix(n + 1, 0.0);
+  for (size_t i = 0; i < n; ++i) prefix[i + 1] = prefix[i] + s.values[i];
+  s.reference.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    size_t lo = i > half ? i - half : 0;
+    size_t hi = std::min(n, i + half + 1);
+    s.reference[i] = static_cast<float>((prefix[hi] - prefix[lo]) / static_cast<double>(hi - lo));
+  }
+  s.first = std::min(n, std::max<size_t>(window, n / 100));
+  double e = 0.0, d = 0.0;
+  for (size_t i = s.first; i < n; ++i) {
+    double x = s.values[i] - s.reference[i];
+    double dx = s.values[i] - s.values[i - 1];
+    e += x * x;
+    d += dx * dx;
+  }
+  double count = static_cast<double>(n - s.first);
+  s.inputError = count > 0 ? std::sqrt(e / count) : 0.0;
+  s.inputRoughness = count > 0 ? std::sqrt(d / count) : 0.0;
+}
+
+Evaluation evaluate(const Series& s, const Candidate& candidate, size_t maxLag, double intervalMs, const Weights& w) {
+  typedef std::chrono::steady_clock Clock;
+  const std::vector<uint32_t>& ts = *s.timestamps;
+  size_t n = s.values.size();
+  std::vector<float> out(n);
+  std::vector<FilterConfig> configs(1, candidate.config);
+  DynamicAdaptiveFilterV2 filter(configs);
+  filter.begin();
+  Clock::time_point t0 = Clock::now();
+  for (size_t i = 0; i < n; ++i) {
+    filter.pushSamples(&s.values[i], 1, ts[i]);
+    out[i] = filter.filteredValues()[0];
+  }
+  double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+  Evaluation ev = {};
+  double e = 0.0, d = 0.0;
+  for (size_t i = s.first; i < n; ++i) {
+    double x = out[i] - s.reference[i];
+    double dx = out[i] - out[i - 1];
+    e += x * x;
+    d += dx * dx;
+  }
+  double count = static_cast<double>(n - s.first);
+  ev.error = s.inputError > 0 ? std::sqrt(e / count) / s.inputError : 0.0;
+  ev.smooth = s.inputRoughness > 0 ? std::sqrt(d / count) / s.inputRoughness : 0.0;
+
+  // Lag: Referenz um k Samples verzögert, Stichprobe mit höchstens ~100k Punkten
+  size_t stride = std::max<size_t>(1, (n - s.first) / 100000);
+  double best = -1.0;
+  size_t bestLag = 0;
+  for (size_t k = 0; k <= maxLag && s.first + k < n; ++k) {
+    double sum = 0.0;
+    for (size_t i = s.first + maxLag; i < n; i += stride) {
+      double x = out[i] - s.reference[i - k];
+      sum += x * x;
+    }
+    if (best < 0.0 || sum < best) {
+      best = sum;
+      bestLag = k;
+    }
+  }
+  ev.lagMs = static_cast<double>(bestLag) * intervalMs;
+  ev.nsPerSample = seconds * 1e9 / static_cast<double>(n);
+  ev.score = w.error * ev.error + w.smooth * ev.smooth + w.lag * ev.lagMs / 1000.0 + w.cpu * ev.nsPerSample / 100.0;
+  if (!std::isfinite(ev.score)) ev.score = INFINITY;
+  return ev;
+}
+
+std::string floatLiteral(float v) {
+  char text[32];
+  std::snprintf(text, sizeof(text), "%g", v);
+  std::string s = text;
+  if (s.find_first_of(".e") == std::string::npos) s += ".0";
+  return s + "f";
+}
+
+const char* typeName(FilterType type) {
+  switch (type) {
+    case EMA: return "EMA";
+    case SMA: return "SMA";
+    case FIR: return "FIR";
+#if defined(USE_KALMAN)
+    case KALMAN: return "KALMAN";
+#endif
+    default: return "?";
+  }
+}
+
+// Initialisierer in der Feldreihenfolge von FilterConfig, wie in params/params_sensors.h
+std::string initializer(const Candidate& c) {
+  const FilterConfig& f = c.config;
+  std::string s = "{";
+  s += typeName(f.type);
+  s += ", " + std::to_string(f.type == FIR ? 0 : f.length);
+  s += f.type == FIR ? std::string(", ") + c.firName + ", " + std::to_string(f.numCoeffs) : std::string(", nullptr, 0");
+  s += ", " + floatLiteral(f.normalFreqHz) + ", " + std::to_string(f.maxDecayTimeMs) + ", " + std::to_string(f.warmUpTimeMs);
+  s += ", " + floatLiteral(f.thresholdPercent) + ", 0.0f, VALUE_MODE";
+#if defined(USE_KALMAN)
+  if (f.type == KALMAN) {
+    s += ", " + floatLiteral(f.madThreshold) + ", " + floatLiteral(f.Q) + ", " + floatLiteral(f.R) + ", 0.0f";
+  } else if (f.madThreshold > 0.0f) {
+    s += ", " + floatLiteral(f.madThreshold);
+  }
+#else
+  if (f.madThreshold > 0.0f) s += ", " + floatLiteral(f.madThreshold);
+#endif
+  return s + "}";
+}
+
+void describe(char* text, size_t size, const Evaluation& ev) {
+  std::snprintf(text, size, "Score %.3f, Fehler %.3f, Glätte %.3f, Lag %.0f ms, %.0f ns/Sample", ev.score, ev.error,
+                ev.smooth, ev.lagMs, ev.nsPerSample);
+}
+
+void usage(const char* argv0) {
+  std::fprintf(stderr,
+               "Aufruf: %s [--set KEY=WERTE]... [--random N] [--seed S] [--channel N] [--threads N]\n"
+               "       [--ref-window N] [--max-lag N] [--weights E,S,L,C] [--top N] [--name NAME] EINGABE\n"
+               "KEY: type, length, fir, q, r, threshold, freq, decay, mad\n",
+               argv0);
+}
+
+}
+
+int main(int argc, char** argv) {
+  Grid grid = defaultGrid();
+  std::string input;
+  std::string name = "tuned";
+  size_t randomCount = 0;
+  unsigned seed = 1;
+  long onlyChannel = -1;
+  size_t threads = std::max(1U, std::thread::hardware_concurrency());
+  size_t refWindow = 21;
+  size_t maxLag = 50;
+  size_t top = 5;
+  Weights weights = {1.0, 0.5, 0.5, 0.1};
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--set" && hasValue) {
+      std::string spec = argv[++i];
+      size_t eq = spec.find('=');
+      std::string key = spec.substr(0, eq);
+      if (eq == std::string::npos || grid.find(key) == grid.end()) {
+        std::fprintf(stderr, "Unbekannter Schlüssel in --set %s\n", spec.c_str());
+        return 2;
+      }
+      grid[key] = split(spec.substr(eq + 1), ',');
+    } else if (arg == "--random" && hasValue) {
+      randomCount = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--seed" && hasValue) {
+      seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--channel" && hasValue) {
+      onlyChannel = std::strtol(argv[++i], nullptr, 10);
+    } else if (arg == "--threads" && hasValue) {
+      threads = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--ref-window" && hasValue) {
+      refWindow = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--max-lag" && hasValue) {
+      maxLag = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--top" && hasValue) {
+      top = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--name" && hasValue) {
+      name = argv[++i];
+      if (name.compare(0, 7, "filter_") == 0) name.erase(0, 7);
+    } else if (arg == "--weights" && hasValue) {
+      std::vector<std::string> w = split(argv[++i], ',');
+      if (w.size() != 4) {
+        usage(argv[0]);
+        return 2;
+      }
+      weights = {std::atof(w[0].c_str()), std::atof(w[1].c_str()), std::atof(w[2].c_str()), std::atof(w[3].c_str())};
+    } else if (arg[0] != '-' && input.empty()) {
+      input = arg;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (input.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  // Log spaltenweise laden (nur die gewählten Kanäle)
+  std::vector<uint32_t> timestamps;
+  std::vector<Series> series;
+  size_t channels = 0;
+  ReadStats stats;
+  bool ok = readLog(input, channels, stats, [&](uint32_t timestamp, const float* values) {
+    if (series.empty()) {
+      if (onlyChannel >= static_cast<long>(channels)) return;
+      series.resize(onlyChannel >= 0 ? 1 : channels);
+    }
+    timestamps.push_back(timestamp);
+    for (size_t k = 0; k < series.size(); ++k) series[k].values.push_back(values[onlyChannel >= 0 ? onlyChannel : k]);
+  });
+  if (!ok) return 1;
+  if (series.empty() || timestamps.size() < 2 * refWindow + 2) {
+    std::fprintf(stderr, "Zu wenige Datensätze oder ungültiger Kanal\n");
+    return 1;
+  }
+
+  // Median-Abstand der Zeitstempel -> freq=auto und Lag in ms
+  std::vector<uint32_t> gaps;
+  for (size_t i = 1; i < timestamps.size(); i += std::max<size_t>(1, timestamps.size() / 100000)) {
+    gaps.push_back(timestamps[i] - timestamps[i - 1]);
+  }
+  std::nth_element(gaps.begin(), gaps.begin() + gaps.size() / 2, gaps.end());
+  double intervalMs = std::max<uint32_t>(1, gaps[gaps.size() / 2]);
+  float autoFreqHz = static_cast<float>(1000.0 / intervalMs);
+
+  std::vector<Candidate> candidates = expand(grid, autoFreqHz);
+  if (randomCount > 0 && randomCount < candidates.size()) {
+    std::mt19937 rng(seed);
+    std::shuffle(candidates.begin(), candidates.end(), rng);
+    candidates.resize(randomCount);
+  }
+  if (candidates.empty()) {
+    std::fprintf(stderr, "Raster ohne gültige Kandidaten\n");
+    return 1;
+  }
+
+  HostClock::useManual(static_cast<uint64_t>(timestamps[0]) * 1000); // Nur gelesen (begin())
+  std::printf("// daf_autotune %s: %zu Datensätze, %.1f Hz, %zu Kandidaten je Kanal, %zu Threads\n", input.c_str(),
+              timestamps.size(), autoFreqHz, candidates.size(), threads);
+  std::printf("// Score = %.2f*Fehler + %.2f*Glätte + %.2f*Lag/s + %.2f*ns/100 (Referenz: %zu Samples zentriert)\n",
+              weights.error, weights.smooth, weights.lag, weights.cpu, refWindow);
+  std::printf("constexpr std::array<FilterConfig, %zu> filter_%s = {{\n", series.size(), name.c_str());
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point t0 = Clock::now();
+  for (size_t k = 0; k < series.size(); ++k) {
+    Series& s = series[k];
+    s.timestamps = &timestamps;
+    prepareReference(s, refWindow);
+
+    std::vector<Evaluation> results(candidates.size());
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+      for (size_t c = next.fetch_add(1); c < candidates.size(); c = next.fetch_add(1)) {
+        results[c] = evaluate(s, candidates[c], maxLag, intervalMs, weights);
+        results[c].candidate = c;
+      }
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+
+    std::sort(results.begin(), results.end(), [](const Evaluation& a, const Evaluation& b) { return a.score < b.score; });
+    size_t channel = onlyChannel >= 0 ? static_cast<size_t>(onlyChannel) : k;
+    char text[160];
+    describe(text, sizeof(text), results[0]);
+    std::printf("  %s%s // ch%zu: %s\n", initializer(candidates[results[0].candidate]).c_str(),
+                k + 1 < series.size() ? "," : "", channel, text);
+    std::fprintf(stderr, "Kanal %zu, beste %zu von %zu:\n", channel, std::min(top, results.size()), results.size());
+    for (size_t r = 0; r < top && r < results.size(); ++r) {
+      describe(text, sizeof(text), results[r]);
+      std::fprintf(stderr, "  %-70s %s\n", initializer(candidates[results[r].candidate]).c_str(), text);
+    }
+  }
+  std::printf("}};\nDAF_VALIDATE_CONFIGS(filter_%s);\n", name.c_str());
+  std::fprintf(stderr, "%zu Bewertungen in %.2f s\n", series.size() * candidates.size(),
+               std::chrono::duration<double>(Clock::now() - t0).count());
+  return 0;
+}
@@ -0,0 +1,202 @@
+// Offline-Replay aufgezeichneter Sensor-Logs durch DynamicAdaptiveFilterV2.
+//
+// Statt neu zu flashen und Serial mitzulesen, läuft ein Log mit seinen
+// eigenen Zeitstempeln durch den Filter, so schnell die CPU kann: Die Uhr
+// des Arduino-Shims wird pro Datensatz auf den Zeitstempel gestellt, Raten-
+// Gate, Decay und CPM sehen also dieselben Abstände wie auf dem Gerät.
+// Eingabe und Ausgabe als CSV oder DAFL (Formate siehe ReplayLog.h), die
+// Eingabe per mmap gestreamt.
+//
+// Die Filterkonfiguration kommt aus einem Profil (params/params_sensors.h),
+// Standard ist EMA(10) für alle Kanäle. --threshold, --mad und --freq
+// überschreiben das jeweilige Feld in allen Kanälen.
+//
+// Aufruf:
+//   daf_replay [--profile NAME] [--threshold X] [--mad X] [--freq HZ] [--every N] [-o AUSGABE] EINGABE
+//   daf_replay --convert EINGABE.csv AUSGABE.dafl
+// Ohne -o wird nur die Zusammenfassung ausgegeben; "-o -" schreibt CSV nach stdout.
+
+#include "DynamicAdaptiveFilterV2.h"
+#include "params/params_sensors.h"
+#include "ReplayLog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Profile {
+  const char* name;
+  const char* description;
+  std::vector<FilterConfig> (*configs)();
+};
+
+template <size_t N>
+std::vector<FilterConfig> tableConfigs(const std::array<FilterConfig, N>& table) {
+  return std::vector<FilterConfig>(table.begin(), table.end());
+}
+
+std::vector<FilterConfig> multiSensorConfigs() {
+  // Kanalbelegung wie examples/MultiSensorFilterExampleV2.ino
+  std::vector<FilterConfig> configs(filter_bme688.begin(), filter_bme688.end());
+  configs.insert(configs.end(), filter_sht45.begin(), filter_sht45.end());
+  configs.insert(configs.end(), filter_gps_neo_m10.begin(), filter_gps_neo_m10.end());
+  configs.insert(configs.end(), filter_mpu6050.begin(), filter_mpu6050.end());
+  return configs;
+}
+
+const Profile kProfiles[] = {
+  {"gps_neo_m10", "GPS NEO-M10: Lat, Lon, Höhe, Speed, Kurs, Sats (GPSM10FilterExample)", []() { return tableConfigs(filter_gps_neo_m10); }},
+  {"mpu6050", "MPU-6050: Acc X/Y/Z, Gyro X/Y/Z", []() { return tableConfigs(filter_mpu6050); }},
+  {"bme688", "BME688: Temp, Feuchte, Druck, Gas", []() { return tableConfigs(filter_bme688); }},
+  {"sht45", "SHT45: Temp, Feuchte", []() { return tableConfigs(filter_sht45); }},
+  {"scd30", "SCD30: CO2, Temp, Feuchte", []() { return tableConfigs(filter_scd30); }},
+  {"multisensor", "BME688 + SHT45 + GPS + MPU-6050, 18 Kanäle (MultiSensorFilterExampleV2)", multiSensorConfigs},
+};
+
+// Standard ohne Profil: EMA(10) auf allen Kanälen
+std::vector<FilterConfig> defaultConfigs(size_t channels, float freqHz) {
+  FilterConfig config = {};
+  config.type = EMA;
+  config.length = 10;
+  config.normalFreqHz = freqHz;
+  config.maxDecayTimeMs = 3600000;
+  config.mode = VALUE_MODE;
+#if defined(USE_KALMAN)
+  config.Q = 0.01f;
+  config.R = 0.1f;
+#endif
+  return std::vector<FilterConfig>(channels, config);
+}
+
+void usage(const char* argv0) {
+  std::fprintf(stderr,
+               "Aufruf: %s [--profile NAME] [--threshold X] [--mad X] [--freq HZ] [--every N] [-o AUSGABE] EINGABE\n"
+               "        %s --convert EINGABE.csv AUSGABE.dafl\n\nProfile:\n",
+               argv0, argv0);
+  for (const Profile& p : kProfiles) std::fprintf(stderr, "  %-12s %s\n", p.name, p.description);
+}
+
+int convert(const std::string& input, const std::string& output) {
+  LogWriter writer;
+  if (!writer.open(output)) return 1;
+  size_t channels = 0;
+  ReadStats stats;
+  bool ok = readLog(input, channels, stats, [&](uint32_t timestamp, const float* values) {
+    writer.write(timestamp, values, channels);
+  });
+  writer.close();
+  if (!ok) return 1;
+  std::fprintf(stderr, "%zu Datensätze x %zu Kanäle, %zu übersprungen\n", stats.records, channels, stats.skipped);
+  return 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+  std::string profileName;
+  std::string input;
+  std::string output;
+  std::string convertOutput;
+  float threshold = -1.0f;
+  float mad = -1.0f;
+  float freqHz = 0.0f;
+  size_t every = 1;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+      profileName = argv[++i];
+    } else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+      threshold = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--mad") == 0 && i + 1 < argc) {
+      mad = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--freq") == 0 && i + 1 < argc) {
+      freqHz = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--every") == 0 && i + 1 < argc) {
+      every = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (std::strcmp(argv[i], "--convert") == 0 && i + 2 < argc) {
+      input = argv[++i];
+      convertOutput = argv[++i];
+    } else if (argv[i][0] != '-' && input.empty()) {
+      input = argv[i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (input.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (!convertOutput.empty()) return convert(input, convertOutput);
+  if (every == 0) every = 1;
+
+  const Profile* profile = nullptr;
+  for (const Profile& p : kProfiles) {
+    if (profileName == p.name) profile = &p;
+  }
+  if (!profileName.empty() && profile == nullptr) {
+    std::fprintf(stderr, "Unbekanntes Profil %s\n", profileName.c_str());
+    usage(argv[0]);
+    return 2;
+  }
+
+  LogWriter writer;
+  if (!output.empty() && !writer.open(output)) return 1;
+
+  // Filter erst mit der Kanalzahl aus dem ersten Datensatz anlegen
+  std::vector<FilterConfig> configs;
+  std::unique_ptr<DynamicAdaptiveFilterV2> filter;
+  bool mismatch = false;
+  uint32_t firstTimestamp = 0;
+  uint32_t lastTimestamp = 0;
+  size_t index = 0;
+  size_t channels = 0;
+  ReadStats stats;
+
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point t0 = Clock::now();
+  bool ok = readLog(input, channels, stats, [&](uint32_t timestamp, const float* values) {
+    if (filter == nullptr) {
+      if (mismatch) return;
+      configs = profile != nullptr ? profile->configs() : defaultConfigs(channels, freqHz > 0.0f ? freqHz : 10.0f);
+      if (configs.size() != channels) {
+        std::fprintf(stderr, "Profil %s hat %zu Kanäle, das Log %zu\n", profile->name, configs.size(), channels);
+        mismatch = true;
+        return;
+      }
+      for (FilterConfig& c : configs) {
+        if (threshold >= 0.0f) c.thresholdPercent = threshold;
+        if (mad >= 0.0f) c.madThreshold = mad;
+        if (freqHz > 0.0f) c.normalFreqHz = freqHz;
+      }
+      HostClock::useManual(static_cast<uint64_t>(timestamp) * 1000);
+      filter.reset(new DynamicAdaptiveFilterV2(configs));
+      filter->begin();
+      firstTimestamp = timestamp;
+    }
+    HostClock::setMillis(timestamp);
+    filter->pushSamples(values, channels, timestamp);
+    lastTimestamp = timestamp;
+    if (writer.enabled() && index % every == 0) writer.write(timestamp, filter->filteredValues(), channels);
+    ++index;
+  });
+  writer.close();
+  double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+  if (!ok || mismatch) return 1;
+
+  double signalSeconds = (lastTimestamp - firstTimestamp) / 1000.0;
+  double samples = static_cast<double>(stats.records) * static_cast<double>(channels);
+  std::fprintf(stderr,
+               "%zu Datensätze x %zu Kanäle (%zu übersprungen), %.0f s Signalzeit in %.3f s: "
+               "%.0fx Echtzeit, %.1f Mio Samples/s\n",
+               stats.records, channels, stats.skipped, signalSeconds, seconds,
+               seconds > 0.0 ? signalSeconds / seconds : 0.0, seconds > 0.0 ? samples / seconds / 1e6 : 0.0);
+  return 0;
+}
@@ -0,0 +1,249 @@
+#ifndef BIQUAD_DESIGN_H
+#define BIQUAD_DESIGN_H
+
+#include <stddef.h>
+#include "FirDesign.h"
+
+// IIR-Entwurf zur Compile-Zeit für den FilterType BIQUAD: Kaskade aus
+// Sektionen zweiter Ordnung, je Sektion {b0, b1, b2, a1, a2} (a0 = 1).
+//
+//   constexpr auto lp = biquadButterworthLowPass<2>(100.0f, 5.0f);     // 4. Ordnung, fs = 100 Hz, fc = 5 Hz
+//   constexpr auto hum = biquadNotch(1000.0f, 50.0f, 4.0f);            // 50 Hz, -3 dB bei 48/52 Hz
+//   constexpr auto both = biquadChain(lp, hum);
+//   FilterConfig c = {BIQUAD, 0, lp.data(), lp.size(), 100.0f, 3600000, 2000, 0.0f, 0.0f, VALUE_MODE};
+//
+// Ergebnis ist wie bei FirDesign.h ein DesignArray<float, 5 * Sections> (ab C++14).
+// Tiefpässe der Ordnung 2 * Sections über den Analog-Prototyp und die
+// bilineare Transformation mit Vorverzerrung (Grenzfrequenz exakt). Jede
+// Sektion hat Gleichanteil-Verstärkung 1, die Kaskade also auch. Sektionen
+// nach steigender Güte sortiert (die schmale Resonanz zuletzt).
+//   Butterworth: maximal flach, fc = -3 dB.
+//   Bessel:      annähernd konstante Gruppenlaufzeit (kaum Überschwingen), fc = -3 dB.
+//   Chebyshev:   steilster Übergang, Welligkeit rippleDb im Durchlassbereich.
+//                Verstärkung dort zwischen 1 und +rippleDb, bei fc wieder 1.
+// Ungültige Frequenzen brechen die Compile-Zeit-Auswertung ab (wie FirDesign.h),
+// ebenso Tiefpässe mit fc / fs unter BIQUAD_MIN_CUTOFF_RATIO: Die Pole liegen
+// dann so nah an 1, dass float-Koeffizienten und -Zustand den Entwurf nicht
+// mehr treffen (Chebyshev 8. Ordnung bei 1e-4 instabil). Darunter erst
+// dezimieren (DECIMATE) und den Tiefpass auf die niedrigere Rate legen.
+
+#ifndef BIQUAD_SECTION_COEFFS
+#define BIQUAD_SECTION_COEFFS 5 // b0, b1, b2, a1, a2
+#endif
+#define BIQUAD_MAX_BESSEL_SECTIONS 6 // Nullstellensuche bis Ordnung 12 geprüft
+#ifndef BIQUAD_MIN_CUTOFF_RATIO
+#define BIQUAD_MIN_CUTOFF_RATIO 0.001 // Kleinstes fc / fs der Tiefpässe (float: < 0,1 dB Abweichung bei fc)
+#endif
+
+// --- constexpr-Mathematik ------------------------------------------------------
+
+struct BiquadComplex {
+  double re;
+  double im;
+};
+
+constexpr BiquadComplex operator+(BiquadComplex a, BiquadComplex b) { return {a.re + b.re, a.im + b.im}; }
+constexpr BiquadComplex operator-(BiquadComplex a, BiquadComplex b) { return {a.re - b.re, a.im - b.im}; }
+constexpr BiquadComplex operator*(BiquadComplex a, BiquadComplex b) {
+  return {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+constexpr BiquadComplex operator/(BiquadComplex a, BiquadComplex b) {
+  double d = b.re * b.re + b.im * b.im;
+  return {(a.re * b.re + a.im * b.im) / d, (a.im * b.re - a.re * b.im) / d};
+}
+constexpr double biquadNorm(BiquadComplex a) { return a.re * a.re + a.im * a.im; }
+
+constexpr double biquadTan(double x) { return firSin(x) / firCos(x); }
+
+constexpr double biquadExp(double x) {
+  // Halbieren bis |x| < 0.5, Taylor-Reihe, dann zurück quadrieren
+  int halvings = 0;
+  while (firAbs(x) >= 0.5 && halvings < 64) {
+    x *= 0.5;
+    ++halvings;
+  }
+  double term = 1.0;
+  double sum = 1.0;
+  for (int i = 1; i < 30 && firAbs(term) > 1e-17; ++i) {
+    term *= x / i;
+    sum += term;
+  }
+  for (int i = 0; i < halvings; ++i) sum *= sum;
+  return sum;
+}
+
+// --- Analoge Prototypen (Grenzfrequenz 1 rad/s) --------------------------------
+
+// Ein Pol je konjugiertem Paar (Imaginärteil > 0)
+template <size_t Sections>
+using BiquadPoles = DesignArray<BiquadComplex, Sections>;
+
+template <size_t Sections>
+constexpr BiquadPoles<Sections> biquadButterworthPoles() {
+  BiquadPoles<Sections> poles{};
+  for (size_t k = 0; k < Sections; ++k) {
+    double theta = firPi * (2.0 * k + 1.0) / (4.0 * Sections);
+    poles[k] = {-firSin(theta), firCos(theta)};
+  }
+  return poles;
+}
+
+template <size_t Sections>
+constexpr BiquadPoles<Sections> biquadChebyshevPoles(double rippleDb) {
+  double epsilon = firSqrt(biquadExp(rippleDb * (2.302585092994046 / 10.0)) - 1.0);
+  if (!(epsilon > 0.0)) epsilon = firInvalidDesign();
+  // e^mu mit mu = asinh(1 / epsilon) / N
+  double e = firRoot(1.0 / epsilon + firSqrt(1.0 / (epsilon * epsilon) + 1.0), 2 * Sections);
+  double sinhMu = 0.5 * (e - 1.0 / e);
+  double coshMu = 0.5 * (e + 1.0 / e);
+  BiquadPoles<Sections> poles{};
+  for (size_t k = 0; k < Sections; ++k) {
+    double theta = firPi * (2.0 * k + 1.0) / (4.0 * Sections);
+    poles[k] = {-sinhMu * firSin(theta), coshMu * firCos(theta)};
+  }
+  return poles;
+}
+
+// Bessel-Polynom theta_N(s) = Summe a_k s^k, a_k = (2N-k)! / (2^(N-k) k! (N-k)!), a_N = 1
+template <size_t N>
+constexpr DesignArray<double, N + 1> biquadBesselPolynomial() {
+  DesignArray<double, N + 1> a{};
+  a[N] = 1.0;
+  // a_(k-1) = a_k * k * (2N-k+1) / (2 * (N-k+1))
+  for (size_t k = N; k > 0; --k) {
+    a[k - 1] = a[k] * static_cast<double>(k) * static_cast<double>(2 * N - k + 1) / (2.0 * static_cast<double>(N - k + 1));
+  }
+  return a;
+}
+
+template <size_t N>
+constexpr BiquadComplex biquadPolyAt(const DesignArray<double, N + 1>& a, BiquadComplex s) {
+  BiquadComplex sum = {a[N], 0.0};
+  for (size_t k = N; k > 0; --k) sum = sum * s + BiquadComplex{a[k - 1], 0.0};
+  return sum;
+}
+
+// Nullstellen per Durand-Kerner, dann auf -3 dB bei 1 rad/s normiert
+template <size_t Sections>
+constexpr BiquadPoles<Sections> biquadBesselPoles() {
+  constexpr size_t N = 2 * Sections;
+  DesignArray<double, N + 1> a = biquadBesselPolynomial<N>();
+  DesignArray<BiquadComplex, N> roots{};
+  BiquadComplex seed = {0.4, 0.9};
+  BiquadComplex power = {1.0, 0.0};
+  for (size_t i = 0; i < N; ++i) {
+    power = power * seed;
+    roots[i] = power * BiquadComplex{firRoot(a[0], static_cast<int>(N)), 0.0}; // Beträge liegen um a_0^(1/N)
+  }
+  for (int iteration = 0; iteration < 500; ++iteration) {
+    double change = 0.0;
+    for (size_t i = 0; i < N; ++i) {
+      BiquadComplex denominator = {1.0, 0.0};
+      for (size_t j = 0; j < N; ++j) {
+        if (j != i) denominator = denominator * (roots[i] - roots[j]);
+      }
+      BiquadComplex step = biquadPolyAt<N>(a, roots[i]) / denominator;
+      roots[i] = roots[i] - step;
+      double relative = biquadNorm(step) / biquadNorm(roots[i]);
+      if (relative > change) change = relative;
+    }
+    if (change < 1e-30) break;
+  }
+
+  // |theta(j w)|^2 = 2 a_0^2 bei w3, per Bisektion (|H| fällt monoton)
+  double low = 0.0;
+  double high = 1.0;
+  while (biquadNorm(biquadPolyAt<N>(a, {0.0, high})) < 2.0 * a[0] * a[0]) high *= 2.0;
+  for (int i = 0; i < 200; ++i) {
+    double mid = 0.5 * (low + high);
+    if (biquadNorm(biquadPolyAt<N>(a, {0.0, mid})) < 2.0 * a[0] * a[0]) low = mid; else high = mid;
+  }
+  double w3 = 0.5 * (low + high);
+
+  BiquadPoles<Sections> poles{};
+  size_t count = 0;
+  for (size_t i = 0; i < N; ++i) {
+    if (roots[i].im > 0.0 && count < Sections) poles[count++] = {roots[i].re / w3, roots[i].im / w3};
+  }
+  if (count != Sections) poles[0].re = firInvalidDesign(); // Keine konjugierten Paare gefunden
+  return poles;
+}
+
+// --- Digitalisierung -----------------------------------------------------------
+
+// Güte eines Polpaars, zum Sortieren der Sektionen
+constexpr double biquadPoleQ(BiquadComplex p) { return firSqrt(biquadNorm(p)) / (-2.0 * p.re); }
+
+// Bilineare Transformation, K = tan(pi fc / fs): H(s) = |p|^2 / (s^2 - 2 Re(p) s + |p|^2)
+template <size_t Sections>
+constexpr DesignArray<float, BIQUAD_SECTION_COEFFS * Sections> biquadLowPassSections(BiquadPoles<Sections> poles, double sampleRateHz,
+                                                                                  double cutoffHz) {
+  double fraction = firCheckedFraction(cutoffHz, sampleRateHz);
+  if (fraction < BIQUAD_MIN_CUTOFF_RATIO) fraction = firInvalidDesign();
+  double K = biquadTan(firPi * fraction);
+  for (size_t i = 1; i < Sections; ++i) {
+    for (size_t j = i; j > 0 && biquadPoleQ(poles[j]) < biquadPoleQ(poles[j - 1]); --j) {
+      BiquadComplex t = poles[j];
+      poles[j] = poles[j - 1];
+      poles[j - 1] = t;
+    }
+  }
+  DesignArray<float, BIQUAD_SECTION_COEFFS * Sections> out{};
+  for (size_t s = 0; s < Sections; ++s) {
+    double mK2 = biquadNorm(poles[s]) * K * K;
+    double sK = 2.0 * poles[s].re * K;
+    double a0 = 1.0 - sK + mK2;
+    float* c = out.data() + BIQUAD_SECTION_COEFFS * s;
+    c[3] = static_cast<float>((2.0 * mK2 - 2.0) / a0);
+    c[4] = static_cast<float>((1.0 + sK + mK2) / a0);
+    // b aus den gerundeten a: Gleichanteil-Verstärkung bleibt 1, auch wenn 1 + a1 + a2 klein ist
+    double b0 = (1.0 + static_cast<double>(c[3]) + static_cast<double>(c[4])) / 4.0;
+    c[0] = static_cast<float>(b0);
+    c[1] = static_cast<float>(2.0 * b0);
+    c[2] = c[0];
+  }
+  return out;
+}
+
+// --- Entwurf -------------------------------------------------------------------
+
+template <size_t Sections>
+constexpr DesignArray<float, BIQUAD_SECTION_COEFFS * Sections> biquadButterworthLowPass(float sampleRateHz, float cutoffHz) {
+  static_assert(Sections >= 1, "biquadButterworthLowPass: Sections >= 1");
+  return biquadLowPassSections<Sections>(biquadButterworthPoles<Sections>(), sampleRateHz, cutoffHz);
+}
+
+template <size_t Sections>
+constexpr DesignArray<float, BIQUAD_SECTION_COEFFS * Sections> biquadBesselLowPass(float sampleRateHz, float cutoffHz) {
+  static_assert(Sections >= 1 && Sections <= BIQUAD_MAX_BESSEL_SECTIONS, "biquadBesselLowPass: 1 <= Sections <= BIQUAD_MAX_BESSEL_SECTIONS");
+  return biquadLowPassSections<Sections>(biquadBesselPoles<Sections>(), sampleRateHz, cutoffHz);
+}
+
+template <size_t Sections>
+constexpr DesignArray<float, BIQUAD_SECTION_COEFFS * Sections> biquadChebyshevLowPass(float sampleRateHz, float cutoffHz, float rippleDb = 1.0f) {
+  static_assert(Sections >= 1, "biquadChebyshevLowPass: Sections >= 1");
+  return biquadLowPassSections<Sections>(biquadChebyshevPoles<Sections>(rippleDb), sampleRateHz, cutoffHz);
+}
+
+// Kerbfilter: Nullstelle bei centerHz, -3 dB bei centerHz ± bandwidthHz / 2, sonst Verstärkung 1
+constexpr DesignArray<float, BIQUAD_SECTION_COEFFS> biquadNotch(float sampleRateHz, float centerHz, float bandwidthHz) {
+  double w0 = 2.0 * firPi * firCheckedFraction(centerHz, sampleRateHz);
+  double alpha = biquadTan(firPi * firCheckedFraction(bandwidthHz, sampleRateHz));
+  float a1 = static_cast<float>(-2.0 * firCos(w0) / (1.0 + alpha));
+  float a2 = static_cast<float>((1.0 - alpha) / (1.0 + alpha));
+  // b0 = 1 / (1 + alpha) = (1 + a2) / 2, aus dem gerundeten a2 (Verstärkung 1 bei 0 Hz und fs/2)
+  float b0 = static_cast<float>(0.5 * (1.0 + static_cast<double>(a2)));
+  return {b0, a1, b0, a1, a2};
+}
+
+// Hintereinanderschalten zweier Entwürfe, z. B. Tiefpass und Netzbrumm-Kerbe
+template <size_t A, size_t B>
+constexpr DesignArray<float, A + B> biquadChain(const DesignArray<float, A>& first, const DesignArray<float, B>& second) {
+  static_assert(A % BIQUAD_SECTION_COEFFS == 0 && B % BIQUAD_SECTION_COEFFS == 0, "biquadChain: ganze Sektionen");
+  DesignArray<float, A + B> out{};
+  for (size_t i = 0; i < A; ++i) out[i] = first[i];
+  for (size_t i = 0; i < B; ++i) out[A + i] = second[i];
+  return out;
+}
+
+#endif
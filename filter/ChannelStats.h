@@ -0,0 +1,168 @@
+#ifndef CHANNEL_STATS_H
+#define CHANNEL_STATS_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#if !defined(ESP32) && !defined(ESP8266) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+#define STATS_HISTOGRAM_BUCKETS 16 // Laufzeit-Buckets: k = floor(log2(Zyklen)), letzter nach oben offen
+#define STATS_SNAPSHOT_RETRIES 8   // Leseversuche von snapshot(), bevor es aufgibt
+
+// Verbleib eines Samples im Hot Path (siehe processSample())
+enum StatsReason {
+  STATS_ACCEPTED,        // Filter aktualisiert bzw. Impuls gezählt
+  STATS_RATE_LIMITED,    // Schneller als expectedIntervalMs / 2
+  STATS_BELOW_THRESHOLD, // Änderung unter thresholdPercent
+  STATS_OUTLIER,         // Von der Hampel/MAD-Vorstufe verworfen
+  STATS_DEAD_TIME,       // COUNT_MODE: innerhalb der Totzeit
+  STATS_REASON_COUNT
+};
+
+// Momentaufnahme der Statistik eines Kanals
+struct FilterStats {
+  uint32_t samples[STATS_REASON_COUNT]; // Samples je StatsReason
+  uint32_t calls;                       // Laufzeitmessungen: je Sample, bei pushBlock() je Block
+  uint32_t lastCycles;
+  uint32_t meanCycles;
+  uint32_t maxCycles;
+  uint32_t histogram[STATS_HISTOGRAM_BUCKETS]; // Messungen mit 2^k <= Zyklen < 2^(k+1), Bucket 0 auch 0 Zyklen
+};
+
+// Zeitbasis der Laufzeitmessung: CPU-Zyklen auf ESP32/ESP8266 und x86-Hosts, sonst µs
+inline uint32_t statsCycles() {
+#if defined(ESP32) || defined(ESP8266)
+  return ESP.getCycleCount();
+#elif defined(__x86_64__) || defined(__i386__)
+  return static_cast<uint32_t>(__rdtsc());
+#else
+  return static_cast<uint32_t>(micros());
+#endif
+}
+
+// Zähler eines Kanals, geschrieben nur von der Task, die den Kanal filtert.
+//
+// Die Felder sind einzelne relaxed-Atomics ohne Read-Modify-Write (ein
+// Schreiber, daher auch auf Kernen ohne Atomic-Befehle billig) und werden
+// per Seqlock konsistent gelesen: record() setzt _seq vor dem Schreiben auf
+// ungerade und danach auf den nächsten geraden Wert, snapshot() wiederholt
+// das Lesen, bis _seq vorher und nachher gleich und gerade war. Der Filter
+// wird dafür nie angehalten. Läuft der Leser auf demselben Kern mit höherer
+// Priorität und hat den Schreiber mitten in record() unterbrochen, gibt
+// snapshot() nach STATS_SNAPSHOT_RETRIES Versuchen false zurück statt zu warten.
+class ChannelStats {
+public:
+  ChannelStats() : _seq(0) { clear(); }
+  // Kopieren nur beim Anlegen der Kanäle; die Kopie beginnt leer
+  ChannelStats(const ChannelStats&) : _seq(0) { clear(); }
+  ChannelStats& operator=(const ChannelStats&) {
+    reset();
+    return *this;
+  }
+
+  // --- Schreiber (Filter-Task) ---
+  void record(StatsReason reason, uint32_t cycles) {
+    uint32_t seq = beginWrite();
+    bump(_samples[reason], 1);
+    addCycles(cycles);
+    endWrite(seq);
+  }
+
+  // Ein Block mit counts[r] Samples je StatsReason und einer gemeinsamen Laufzeit
+  void recordBlock(const uint32_t* counts, uint32_t cycles) {
+    uint32_t seq = beginWrite();
+    for (size_t r = 0; r < STATS_REASON_COUNT; ++r) {
+      if (counts[r] > 0) bump(_samples[r], counts[r]);
+    }
+    addCycles(cycles);
+    endWrite(seq);
+  }
+
+  void reset() {
+    uint32_t seq = beginWrite();
+    clear();
+    endWrite(seq);
+  }
+
+  // --- Leser (beliebige Task/Kern) ---
+  bool snapshot(FilterStats& out) const {
+    for (int attempt = 0; attempt < STATS_SNAPSHOT_RETRIES; ++attempt) {
+      uint32_t before = _seq.load(std::memory_order_acquire);
+      if (before & 1) continue;
+      for (size_t r = 0; r < STATS_REASON_COUNT; ++r) out.samples[r] = _samples[r].load(std::memory_order_relaxed);
+      out.calls = _calls.load(std::memory_order_relaxed);
+      out.lastCycles = _lastCycles.load(std::memory_order_relaxed);
+      out.maxCycles = _maxCycles.load(std::memory_order_relaxed);
+      uint64_t sum = (static_cast<uint64_t>(_cycleSumHigh.load(std::memory_order_relaxed)) << 32) |
+                     _cycleSumLow.load(std::memory_order_relaxed);
+      for (size_t k = 0; k < STATS_HISTOGRAM_BUCKETS; ++k) out.histogram[k] = _histogram[k].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (_seq.load(std::memory_order_relaxed) == before) {
+        out.meanCycles = out.calls > 0 ? static_cast<uint32_t>(sum / out.calls) : 0;
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  std::atomic<uint32_t> _seq; // Ungerade während eines Schreibvorgangs
+  std::atomic<uint32_t> _samples[STATS_REASON_COUNT];
+  std::atomic<uint32_t> _calls;
+  std::atomic<uint32_t> _lastCycles;
+  std::atomic<uint32_t> _maxCycles;
+  std::atomic<uint32_t> _cycleSumLow; // Summe aller Laufzeiten (64 Bit, für meanCycles)
+  std::atomic<uint32_t> _cycleSumHigh;
+  std::atomic<uint32_t> _histogram[STATS_HISTOGRAM_BUCKETS];
+
+  static void bump(std::atomic<uint32_t>& field, uint32_t n) {
+    field.store(field.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  static size_t histogramBucket(uint32_t cycles) {
+    size_t bucket = 0;
+#if defined(__GNUC__)
+    if (cycles > 1) bucket = 31 - __builtin_clz(cycles);
+#else
+    while (cycles > 1) {
+      cycles >>= 1;
+      ++bucket;
+    }
+#endif
+    return bucket < STATS_HISTOGRAM_BUCKETS ? bucket : STATS_HISTOGRAM_BUCKETS - 1;
+  }
+
+  uint32_t beginWrite() {
+    uint32_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+  }
+
+  void endWrite(uint32_t seq) { _seq.store(seq + 2, std::memory_order_release); }
+
+  void addCycles(uint32_t cycles) {
+    bump(_calls, 1);
+    _lastCycles.store(cycles, std::memory_order_relaxed);
+    if (cycles > _maxCycles.load(std::memory_order_relaxed)) _maxCycles.store(cycles, std::memory_order_relaxed);
+    uint32_t low = _cycleSumLow.load(std::memory_order_relaxed);
+    _cycleSumLow.store(low + cycles, std::memory_order_relaxed);
+    if (low + cycles < low) bump(_cycleSumHigh, 1);
+    bump(_histogram[histogramBucket(cycles)], 1);
+  }
+
+  void clear() {
+    for (size_t r = 0; r < STATS_REASON_COUNT; ++r) _samples[r].store(0, std::memory_order_relaxed);
+    _calls.store(0, std::memory_order_relaxed);
+    _lastCycles.store(0, std::memory_order_relaxed);
+    _maxCycles.store(0, std::memory_order_relaxed);
+    _cycleSumLow.store(0, std::memory_order_relaxed);
+    _cycleSumHigh.store(0, std::memory_order_relaxed);
+    for (size_t k = 0; k < STATS_HISTOGRAM_BUCKETS; ++k) _histogram[k].store(0, std::memory_order_relaxed);
+  }
+};
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "FilterMath.h"
+
+#define DECIMATOR_MAX_CIC_STAGES 5
+#define DECIMATOR_MAX_CIC_FACTOR 1024      // Begrenzt auch die Rechenzeit von reset()
+#define DECIMATOR_CIC_GROWTH_BITS 32       // Reserve der 64-Bit-Register über dem 32-Bit-Eingang
+#define DECIMATOR_CIC_FRACTION_BITS 24     // CIC-Eingang: fullScale entspricht 2^24, sättigt bei 128 * fullScale
+
+// Mehrratenfilter für schnell abgetastete Kanäle (FilterType DECIMATE).
+//
+// Optionale CIC-Vorstufe (Hogenauer: cicStages Integratoren mit der
+// Eingangsrate, ebenso viele Kämme mit der Ausgangsrate, Faktor cicFactor),
+// danach ein FIR-Tiefpass, der um factor dezimiert. Jeder Eingangswert wird
+// verarbeitet, ein Ausgang entsteht alle cicFactor * factor Eingänge.
+//
+// Das FIR läuft als transponierte Polyphasenstruktur: Ein Eingang der Phase q
+// geht mit Teilkern q in L = ceil(numCoeffs / factor) Teilsummen der nächsten
+// Ausgänge ein. Aufwand je Eingang L Multiplikationen statt numCoeffs, gleich-
+// mäßig verteilt (kein Rechenstoß beim Ausgang), Speicher L Teilsummen statt
+// einer Historie aus numCoeffs Werten.
+//
+// Die CIC-Register rechnen ganzzahlig modulo 2^64; der Überlauf der
+// Integratoren hebt sich in den Kämmen auf, solange das Ergebnis passt
+// (stages * ceil(log2(cicFactor)) <= DECIMATOR_CIC_GROWTH_BITS). Der Eingang
+// wird dazu relativ zu fullScale quantisiert (0 = aus dem ersten Sample wie
+// DAF_FIXED_POINT). Das FIR rechnet in float, auch im Festkomma-Build.
+
+// Ein return je constexpr-Funktion: auch mit -std=gnu++11 auswertbar
+constexpr int decimatorCeilLog2(int n, int bits = 0) {
+  return bits < 31 && (1LL << bits) < n ? decimatorCeilLog2(n, bits + 1) : bits;
+}
+
+// Gültige CIC-Parameter; stages == 0 = ohne CIC
+constexpr bool decimatorCicValid(int stages, int factor) {
+  return stages == 0 ||
+         (stages > 0 && stages <= DECIMATOR_MAX_CIC_STAGES && factor >= 2 && factor <= DECIMATOR_MAX_CIC_FACTOR &&
+          stages * decimatorCeilLog2(factor) <= DECIMATOR_CIC_GROWTH_BITS);
+}
+
+class Decimator {
+public:
+  Decimator() { clear(); }
+
+  // Aus (alle Typen außer DECIMATE)
+  void clear() {
+    reset(nullptr, 0, 1, 0, 1, 0.0f);
+  }
+
+  // coeffs == nullptr: nur CIC. Parameter wie von decimatorCicValid() geprüft.
+  void reset(const float* coeffs, int numCoeffs, int factor, int cicStages, int cicFactor, float fullScale) {
+    _factor = factor > 1 ? factor : 1;
+    _taps = coeffs != nullptr && numCoeffs > 0 ? (static_cast<size_t>(numCoeffs) + _factor - 1) / _factor : 0;
+    _phases.assign(_taps * _factor, 0.0f);
+    for (size_t q = 0; q < _factor; ++q) {
+      for (size_t j = 0; j < _taps; ++j) {
+        size_t k = j * _factor + _factor - 1 - q;
+        if (k < static_cast<size_t>(numCoeffs)) _phases[q * _taps + j] = coeffs[k];
+      }
+    }
+    _acc.assign(_taps, 0.0f);
+    _phase = 0;
+    _head = 0;
+
+    _cicStages = cicStages > 0 && cicStages <= DECIMATOR_MAX_CIC_STAGES ? cicStages : 0;
+    _cicFactor = _cicStages > 0 && cicFactor > 1 ? cicFactor : 1;
+    _fullScale = fullScale;
+    setScale(0.0f);
+    // Zustand nach stages * cicFactor Einsen ab Null: eingeschwungen, da die
+    // Impulsantwort stages * (cicFactor - 1) + 1 Samples lang ist. Für einen
+    // konstanten Eingang x ist der Zustand x-mal so groß (linear, modulo 2^64).
+    clearCic();
+    for (size_t i = 0; i < _cicStages * _cicFactor; ++i) cicStep(1);
+    for (size_t s = 0; s < _cicStages; ++s) {
+      _unitIntegrators[s] = _integrators[s];
+      _unitCombs[s] = _combs[s];
+    }
+    clearCic();
+    _primed = false;
+  }
+
+  bool enabled() const { return _taps > 0 || _cicStages > 0; }
+  bool primed() const { return _primed; }
+  size_t factor() const { return _factor * _cicFactor; } // Eingänge je Ausgang
+
+  // Eingeschwungener Zustand für einen konstanten Eingang value (Start, nach einer Lücke)
+  void prime(float value) {
+    if (_scale == 0.0f) setScale(filterFullScale(_fullScale, value));
+    if (_cicStages > 0) {
+      uint64_t x = static_cast<uint64_t>(static_cast<int64_t>(quantize(value)));
+      for (size_t s = 0; s < _cicStages; ++s) {
+        _integrators[s] = _unitIntegrators[s] * x;
+        _combs[s] = _unitCombs[s] * x;
+      }
+      _cicPhase = 0;
+      value = static_cast<float>(quantize(value)) * _fromFixed * static_cast<float>(_cicGain);
+    }
+    // Teilsumme j enthält alle Koeffizienten ab Zeile j + 1 (Werte vor dem Start)
+    float past = 0.0f;
+    for (size_t j = _taps; j-- > 0;) {
+      _acc[j] = past * value;
+      for (size_t q = 0; q < _factor; ++q) past += _phases[q * _taps + j];
+    }
+    _phase = 0;
+    _head = 0;
+    _primed = true;
+  }
+
+  // true, wenn mit diesem Eingang ein neuer Ausgang in output steht
+  bool push(float value, float& output) {
+    if (_cicStages > 0) {
+      int64_t y = 0;
+      if (!cicStep(static_cast<uint64_t>(static_cast<int64_t>(quantize(value))), &y)) return false;
+      value = static_cast<float>(y) * _fromFixed;
+    }
+    if (_taps == 0) {
+      output = value;
+      return true;
+    }
+    // Teilsummen liegen als Ring ab _head: zwei zusammenhängende Abschnitte
+    const float* c = _phases.data() + _phase * _taps;
+    size_t first = _taps - _head;
+    dspScaledAdd(_acc.data() + _head, value, c, first);
+    dspScaledAdd(_acc.data(), value, c + first, _head);
+    if (++_phase < _factor) return false;
+    _phase = 0;
+    output = _acc[_head];
+    _acc[_head] = 0.0f;
+    _head = _head + 1 == _taps ? 0 : _head + 1;
+    return true;
+  }
+
+  // Snapshot (filter/Snapshot.h): Aufbau muss zur Konfiguration passen
+  template <typename Archive>
+  void save(Archive& out) const {
+    out.u32(_taps);
+    out.u32(_factor);
+    out.u32(_cicStages);
+    out.u32(_cicFactor);
+    out.io(_primed);
+    out.io(_scale);
+    out.u32(_phase);
+    out.u32(_head);
+    out.array(_acc.data(), _taps);
+    out.u32(_cicPhase);
+    out.array(_integrators, _cicStages);
+    out.array(_combs, _cicStages);
+  }
+
+  template <typename Archive>
+  void restore(Archive& in) {
+    size_t taps = 0, factor = 0, cicStages = 0, cicFactor = 0;
+    in.u32(taps);
+    in.u32(factor);
+    in.u32(cicStages);
+    in.u32(cicFactor);
+    if (taps != _taps || factor != _factor || cicStages != _cicStages || cicFactor != _cicFactor) {
+      in.fail();
+      return;
+    }
+    float scale = 0.0f;
+    in.io(_primed);
+    in.io(scale);
+    setScale(scale);
+    in.u32(_phase);
+    in.u32(_head);
+    in.array(_acc.data(), _taps);
+    in.u32(_cicPhase);
+    in.array(_integrators, _cicStages);
+    in.array(_combs, _cicStages);
+    if (_phase >= _factor || (_taps > 0 && _head >= _taps) || _cicPhase >= _cicFactor) in.fail();
+  }
+
+private:
+  std::vector<float> _phases; // Teilkern q ab _phases[q * _taps]: Zeile j = coeffs[j * factor + factor - 1 - q]
+  std::vector<float> _acc;    // Teilsummen der nächsten _taps Ausgänge, Ring ab _head
+  size_t _factor;
+  size_t _taps;
+  size_t _phase;              // Eingänge seit dem letzten FIR-Ausgang
+  size_t _head;
+  bool _primed;
+
+  size_t _cicStages;
+  size_t _cicFactor;
+  size_t _cicPhase;
+  uint64_t _cicGain;          // cicFactor^stages
+  uint64_t _integrators[DECIMATOR_MAX_CIC_STAGES];
+  uint64_t _combs[DECIMATOR_MAX_CIC_STAGES]; // Letzter Eingang je Kamm (Verzögerung 1)
+  uint64_t _unitIntegrators[DECIMATOR_MAX_CIC_STAGES];
+  uint64_t _unitCombs[DECIMATOR_MAX_CIC_STAGES];
+  float _fullScale;
+  float _scale;               // 0 bis zum ersten prime()
+  float _toFixed;
+  float _fromFixed;           // Einschließlich 1 / _cicGain
+
+  void setScale(float scale) {
+    _cicGain = 1;
+    for (size_t s = 0; s < _cicStages; ++s) _cicGain *= _cicFactor;
+    _scale = scale;
+    _toFixed = scale > 0.0f ? static_cast<float>(1L << DECIMATOR_CIC_FRACTION_BITS) / scale : 0.0f;
+    _fromFixed = scale > 0.0f ? static_cast<float>(static_cast<double>(scale) / (static_cast<double>(1L << DECIMATOR_CIC_FRACTION_BITS) *
+                                                                              static_cast<double>(_cicGain)))
+                              : 0.0f;
+  }
+
+  void clearCic() {
+    for (size_t s = 0; s < DECIMATOR_MAX_CIC_STAGES; ++s) {
+      _integrators[s] = 0;
+      _combs[s] = 0;
+    }
+    _cicPhase = 0;
+  }
+
+  int32_t quantize(float value) const {
+    float x = value * _toFixed;
+    if (x >= 2147483520.0f) return INT32_MAX; // Größter float unter 2^31
+    if (x <= -2147483648.0f) return INT32_MIN;
+    return static_cast<int32_t>(x < 0.0f ? x - 0.5f : x + 0.5f);
+  }
+
+  // Ein Eingang; true mit *output (Verstärkung cicGain) am Ende jedes Blocks
+  bool cicStep(uint64_t x, int64_t* output = nullptr) {
+    for (size_t s = 0; s < _cicStages; ++s) {
+      _integrators[s] += x;
+      x = _integrators[s];
+    }
+    if (++_cicPhase < _cicFactor) return false;
+    _cicPhase = 0;
+    for (size_t s = 0; s < _cicStages; ++s) {
+      uint64_t previous = _combs[s];
+      _combs[s] = x;
+      x -= previous;
+    }
+    if (output) *output = static_cast<int64_t>(x);
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,338 @@
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include <stddef.h>
+
+// Vektorisierte Kernels für FIR-Skalarprodukt (auch gefaltet für symmetrische
+// Koeffizienten) und LMS-Koeffizienten-Update.
+//
+// Auswahl des Backends:
+//   - x86/x86_64: SSE2 als Basis, AVX2+FMA per Laufzeit-Erkennung (GCC/Clang)
+//   - ARM mit NEON: zur Compile-Zeit
+//   - ESP32/ESP32-S3 mit esp-dsp: dsps_dotprod_f32 (nutzt ae32/aes3-Assembler)
+//   - sonst skalar mit vier Akkumulatoren
+// Mit DSP_FORCE_SCALAR wird immer der skalare Pfad gewählt.
+// Sehr kurze Vektoren (< DSP_SIMD_MIN_LENGTH) laufen inline skalar, da dort
+// der indirekte Aufruf teurer ist als die Rechnung selbst.
+
+#ifndef DSP_SIMD_MIN_LENGTH
+#define DSP_SIMD_MIN_LENGTH 8
+#endif
+
+#if !defined(DSP_FORCE_SCALAR)
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+#define DSP_HAVE_SSE2 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DSP_HAVE_NEON 1
+#include <arm_neon.h>
+#elif defined(ESP_PLATFORM) && defined(__has_include)
+#if __has_include("dsps_dotprod.h")
+#define DSP_HAVE_ESP_DSP 1
+#include "dsps_dotprod.h"
+#endif
+#endif
+#endif
+
+// Gefaltetes FIR (firDecayedOutput()) für float: spart die Hälfte der
+// Multiplikationen, zahlt sich aber nur ohne Vektor-Backend aus. Mit SSE2/AVX2
+// ist das einfache Skalarprodukt gleich schnell oder schneller (bench_kernels).
+#ifndef DSP_FOLD_SYMMETRIC
+#if defined(DSP_HAVE_SSE2) || defined(DSP_HAVE_NEON) || defined(DSP_HAVE_ESP_DSP)
+#define DSP_FOLD_SYMMETRIC 0
+#else
+#define DSP_FOLD_SYMMETRIC 1
+#endif
+#endif
+
+typedef float (*DspDotFn)(const float* a, const float* b, size_t n);
+typedef void (*DspScaledAddFn)(float* y, float alpha, const float* x, size_t n);
+typedef float (*DspFoldedDotFn)(const float* c, const float* lo, const float* hi, size_t n);
+
+struct DspKernels {
+  const char* name;
+  DspDotFn dot;             // sum(a[i] * b[i])
+  DspScaledAddFn scaledAdd; // y[i] += alpha * x[i]
+  DspFoldedDotFn foldedDot; // sum(c[i] * (lo[i] + hi[n - 1 - i])), symmetrischer FIR mit halb so vielen Multiplikationen
+};
+
+// --- Skalar ------------------------------------------------------------------
+
+inline float dspDotScalar(const float* a, const float* b, size_t n) {
+  float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += a[i] * b[i];
+    s1 += a[i + 1] * b[i + 1];
+    s2 += a[i + 2] * b[i + 2];
+    s3 += a[i + 3] * b[i + 3];
+  }
+  for (; i < n; ++i) s0 += a[i] * b[i];
+  return (s0 + s1) + (s2 + s3);
+}
+
+inline void dspScaledAddScalar(float* y, float alpha, const float* x, size_t n) {
+  for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+inline float dspFoldedDotScalar(const float* c, const float* lo, const float* hi, size_t n) {
+  float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+  const float* h = hi + n - 1;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    s0 += c[i] * (lo[i] + h[-static_cast<ptrdiff_t>(i)]);
+    s1 += c[i + 1] * (lo[i + 1] + h[-static_cast<ptrdiff_t>(i) - 1]);
+    s2 += c[i + 2] * (lo[i + 2] + h[-static_cast<ptrdiff_t>(i) - 2]);
+    s3 += c[i + 3] * (lo[i + 3] + h[-static_cast<ptrdiff_t>(i) - 3]);
+  }
+  for (; i < n; ++i) s0 += c[i] * (lo[i] + hi[n - 1 - i]);
+  return (s0 + s1) + (s2 + s3);
+}
+
+// --- SSE2 / AVX2 -------------------------------------------------------------
+
+#if defined(DSP_HAVE_SSE2)
+inline float dspHsumSse(__m128 v) {
+  __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+  __m128 sums = _mm_add_ps(v, shuf);
+  shuf = _mm_movehl_ps(shuf, sums);
+  sums = _mm_add_ss(sums, shuf);
+  return _mm_cvtss_f32(sums);
+}
+
+inline float dspDotSse2(const float* a, const float* b, size_t n) {
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  float sum = dspHsumSse(_mm_add_ps(acc0, acc1));
+  for (; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+inline void dspScaledAddSse2(float* y, float alpha, const float* x, size_t n) {
+  __m128 va = _mm_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(va, _mm_loadu_ps(x + i))));
+  }
+  for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+// hi wird rückwärts gelesen: Block hi[n-i-4 .. n-i-1] umgedreht passt zu lo[i .. i+3]
+inline float dspFoldedDotSse2(const float* c, const float* lo, const float* hi, size_t n) {
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128 h0 = _mm_loadu_ps(hi + n - i - 4);
+    __m128 h1 = _mm_loadu_ps(hi + n - i - 8);
+    h0 = _mm_shuffle_ps(h0, h0, _MM_SHUFFLE(0, 1, 2, 3));
+    h1 = _mm_shuffle_ps(h1, h1, _MM_SHUFFLE(0, 1, 2, 3));
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(c + i), _mm_add_ps(_mm_loadu_ps(lo + i), h0)));
+    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(c + i + 4), _mm_add_ps(_mm_loadu_ps(lo + i + 4), h1)));
+  }
+  for (; i + 4 <= n; i += 4) {
+    __m128 h0 = _mm_loadu_ps(hi + n - i - 4);
+    h0 = _mm_shuffle_ps(h0, h0, _MM_SHUFFLE(0, 1, 2, 3));
+    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(c + i), _mm_add_ps(_mm_loadu_ps(lo + i), h0)));
+  }
+  float sum = dspHsumSse(_mm_add_ps(acc0, acc1));
+  for (; i < n; ++i) sum += c[i] * (lo[i] + hi[n - 1 - i]);
+  return sum;
+}
+
+__attribute__((target("avx2,fma")))
+inline float dspDotAvx2(const float* a, const float* b, size_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+  }
+  acc0 = _mm256_add_ps(acc0, acc1);
+  __m128 v = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+  __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+  __m128 sums = _mm_add_ps(v, shuf);
+  shuf = _mm_movehl_ps(shuf, sums);
+  sums = _mm_add_ss(sums, shuf);
+  float sum = _mm_cvtss_f32(sums);
+  for (; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+__attribute__((target("avx2,fma")))
+inline void dspScaledAddAvx2(float* y, float alpha, const float* x, size_t n) {
+  __m256 va = _mm256_set1_ps(alpha);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(y + i, _mm256_fmadd_ps(va, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+  }
+  for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+__attribute__((target("avx2,fma")))
+inline float dspFoldedDotAvx2(const float* c, const float* lo, const float* hi, size_t n) {
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256 h0 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(hi + n - i - 8), reverse);
+    __m256 h1 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(hi + n - i - 16), reverse);
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(c + i), _mm256_add_ps(_mm256_loadu_ps(lo + i), h0), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(c + i + 8), _mm256_add_ps(_mm256_loadu_ps(lo + i + 8), h1), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m256 h0 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(hi + n - i - 8), reverse);
+    acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(c + i), _mm256_add_ps(_mm256_loadu_ps(lo + i), h0), acc0);
+  }
+  acc0 = _mm256_add_ps(acc0, acc1);
+  float sum = dspHsumSse(_mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+  for (; i < n; ++i) sum += c[i] * (lo[i] + hi[n - 1 - i]);
+  return sum;
+}
+#endif
+
+// --- NEON --------------------------------------------------------------------
+
+#if defined(DSP_HAVE_NEON)
+inline float dspDotNeon(const float* a, const float* b, size_t n) {
+  float32x4_t acc0 = vdupq_n_f32(0.0f);
+  float32x4_t acc1 = vdupq_n_f32(0.0f);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+  }
+  acc0 = vaddq_f32(acc0, acc1);
+  float32x2_t half = vadd_f32(vget_low_f32(acc0), vget_high_f32(acc0));
+  float sum = vget_lane_f32(vpadd_f32(half, half), 0);
+  for (; i < n; ++i) sum += a[i] * b[i];
+  return sum;
+}
+
+inline void dspScaledAddNeon(float* y, float alpha, const float* x, size_t n) {
+  float32x4_t va = vdupq_n_f32(alpha);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(y + i, vmlaq_f32(vld1q_f32(y + i), va, vld1q_f32(x + i)));
+  }
+  for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+inline float dspFoldedDotNeon(const float* c, const float* lo, const float* hi, size_t n) {
+  float32x4_t acc = vdupq_n_f32(0.0f);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t h = vrev64q_f32(vld1q_f32(hi + n - i - 4));
+    h = vcombine_f32(vget_high_f32(h), vget_low_f32(h));
+    acc = vmlaq_f32(acc, vld1q_f32(c + i), vaddq_f32(vld1q_f32(lo + i), h));
+  }
+  float32x2_t half = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+  float sum = vget_lane_f32(vpadd_f32(half, half), 0);
+  for (; i < n; ++i) sum += c[i] * (lo[i] + hi[n - 1 - i]);
+  return sum;
+}
+#endif
+
+// --- esp-dsp -----------------------------------------------------------------
+
+#if defined(DSP_HAVE_ESP_DSP)
+inline float dspDotEspDsp(const float* a, const float* b, size_t n) {
+  float result = 0.0f;
+  dsps_dotprod_f32(a, b, &result, static_cast<int>(n));
+  return result;
+}
+#endif
+
+// --- Dispatch ----------------------------------------------------------------
+
+inline const DspKernels& dspScalarKernels() {
+  static const DspKernels k = {"scalar", dspDotScalar, dspScaledAddScalar, dspFoldedDotScalar};
+  return k;
+}
+
+struct DspKernelList {
+  DspKernels items[3];
+  size_t count;
+};
+
+inline DspKernelList dspDetectKernels() {
+  DspKernelList list;
+  list.count = 0;
+  list.items[list.count++] = dspScalarKernels();
+#if defined(DSP_HAVE_SSE2)
+  list.items[list.count++] = DspKernels{"sse2", dspDotSse2, dspScaledAddSse2, dspFoldedDotSse2};
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    list.items[list.count++] = DspKernels{"avx2", dspDotAvx2, dspScaledAddAvx2, dspFoldedDotAvx2};
+  }
+#elif defined(DSP_HAVE_NEON)
+  list.items[list.count++] = DspKernels{"neon", dspDotNeon, dspScaledAddNeon, dspFoldedDotNeon};
+#elif defined(DSP_HAVE_ESP_DSP)
+  list.items[list.count++] = DspKernels{"esp-dsp", dspDotEspDsp, dspScaledAddScalar, dspFoldedDotScalar};
+#endif
+  return list;
+}
+
+// Alle auf dieser Maschine lauffähigen Backends, schnellstes zuletzt
+inline const DspKernels* dspAvailableKernels(size_t* count) {
+  static const DspKernelList list = dspDetectKernels();
+  if (count) *count = list.count;
+  return list.items;
+}
+
+inline const DspKernels* dspSelectFastest() {
+  size_t n = 0;
+  const DspKernels* list = dspAvailableKernels(&n);
+  return &list[n - 1];
+}
+
+// Aktives Backend, einmalig beim ersten Aufruf ermittelt
+inline const DspKernels& dspKernels() {
+  static const DspKernels* const active = dspSelectFastest();
+  return *active;
+}
+
+inline float dspDotProduct(const float* a, const float* b, size_t n) {
+  if (n < DSP_SIMD_MIN_LENGTH) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+  }
+  return dspKernels().dot(a, b, n);
+}
+
+inline void dspScaledAdd(float* y, float alpha, const float* x, size_t n) {
+  if (n < DSP_SIMD_MIN_LENGTH) {
+    for (size_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+    return;
+  }
+  dspKernels().scaledAdd(y, alpha, x, n);
+}
+
+// n = Anzahl Paare; hi zeigt auf den Anfang der oberen Hälfte (aufsteigend)
+inline float dspFoldedDot(const float* c, const float* lo, const float* hi, size_t n) {
+  if (n < DSP_SIMD_MIN_LENGTH) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) sum += c[i] * (lo[i] + hi[n - 1 - i]);
+    return sum;
+  }
+  return dspKernels().foldedDot(c, lo, hi, n);
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef FILTER_COEFFICIENTS_Q15_H
+#define FILTER_COEFFICIENTS_Q15_H
+
+#include "FIR_coefficients.h"
+#include "FixedPoint.h"
+
+// Q15-Fassung der Tabellen aus FIR_coefficients.h, zur Compile-Zeit umgerechnet
+// (für updateFIRCoeffs() im DAF_FIXED_POINT-Build, kein Float zur Laufzeit)
+
+constexpr auto chebyshev_lowpass_order1_q15 = toQ15Table(chebyshev_lowpass_order1);
+constexpr auto chebyshev_lowpass_order2_q15 = toQ15Table(chebyshev_lowpass_order2);
+constexpr auto chebyshev_lowpass_order3_q15 = toQ15Table(chebyshev_lowpass_order3);
+
+constexpr auto bessel_lowpass_order1_q15 = toQ15Table(bessel_lowpass_order1);
+constexpr auto bessel_lowpass_order2_q15 = toQ15Table(bessel_lowpass_order2);
+constexpr auto bessel_lowpass_order3_q15 = toQ15Table(bessel_lowpass_order3);
+
+constexpr auto butterworth_lowpass_order1_q15 = toQ15Table(butterworth_lowpass_order1);
+constexpr auto butterworth_lowpass_order2_q15 = toQ15Table(butterworth_lowpass_order2);
+constexpr auto butterworth_lowpass_order3_q15 = toQ15Table(butterworth_lowpass_order3);
+
+constexpr auto notch_50hz_q15 = toQ15Table(notch_50hz);
+
+static_assert(butterworth_lowpass_order2_q15[2] == 9830, "Q15-Umrechnung der FIR-Tabellen");
+
+#endif
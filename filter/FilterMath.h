@@ -0,0 +1,303 @@
+#ifndef FILTER_MATH_H
+#define FILTER_MATH_H
+
+#include <math.h>
+#include "StreamingMAD.h"
+#include "DspKernels.h"
+
+// Gemeinsame Rechenschritte der Filter, unabhängig von USE_KALMAN/USE_LMS/
+// USE_RLS. Genutzt von DynamicAdaptiveFilterV2 und den Policies in
+// FilterPolicies.h, damit beide Wege bitgleich rechnen.
+
+#ifndef RLS_INITIAL_P
+#define RLS_INITIAL_P 100.0f // RLS: Startwert der Diagonale von P (1/delta)
+#endif
+#ifndef RLS_MAX_P
+#define RLS_MAX_P 1e6f // RLS: Obergrenze der mittleren P-Diagonale, darüber wird nicht mehr vergessen
+#endif
+#ifndef BIQUAD_SECTION_COEFFS
+#define BIQUAD_SECTION_COEFFS 5 // b0, b1, b2, a1, a2
+#endif
+
+#ifndef TIME_REORDER_WINDOW_MS
+#define TIME_REORDER_WINDOW_MS 3600000UL // Zeitstempel bis 1 h vor dem letzten gelten als verspätet
+#endif
+
+// Zeit von since bis now in ms, modulo der Breite von T (millis() läuft nach
+// ~49 Tagen über). 0 nur für verspätete Zeitstempel höchstens
+// TIME_REORDER_WINDOW_MS vor since; jede andere Differenz ist vergangene Zeit,
+// auch Lücken über 2^31 ms. Ohne Verzweigung, vektorisiert in Schleifen.
+template <typename T>
+inline T elapsedSince(T now, T since) {
+  return static_cast<T>(since - now) <= TIME_REORDER_WINDOW_MS ? 0 : static_cast<T>(now - since);
+}
+
+inline unsigned long timeSince(unsigned long now, unsigned long since) {
+  return elapsedSince(now, since);
+}
+
+// Raten-Gate: deltaT seit dem letzten angenommenen Sample. Vor dem ersten
+// Sample (pushed == false) zählt die Zeit ab 0, also seit dem Start von millis().
+template <typename T>
+inline T pushDeltaT(T now, T lastPushTime, bool pushed) {
+  return pushed ? elapsedSince(now, lastPushTime) : static_cast<T>(now - lastPushTime);
+}
+
+// Vollausschlag aus fullScale oder aus dem ersten Sample
+// (nächste Zweierpotenz >= 4 * |value|, mindestens 1)
+inline float filterFullScale(float fullScale, float value) {
+  if (fullScale > 0.0f) return fullScale;
+  float scale = 1.0f;
+  while (scale < 4.0f * fabsf(value) && scale < 1e30f) scale *= 2.0f;
+  return scale;
+}
+
+// 1 bis expectedIntervalMs, danach linear auf 0 bei maxDecayTimeMs
+inline float filterDecayFactor(unsigned long deltaT, unsigned long expectedIntervalMs, unsigned long maxDecayTimeMs) {
+  if (deltaT <= expectedIntervalMs) {
+    return 1.0f;
+  } else if (deltaT >= maxDecayTimeMs) {
+    return 0.0f;
+  } else {
+    return 1.0f - static_cast<float>(deltaT - expectedIntervalMs) / static_cast<float>(maxDecayTimeMs - expectedIntervalMs);
+  }
+}
+
+// Schmitt-Trigger: relative Änderung zum gefilterten Wert in Prozent
+inline bool filterSignificantChange(float value, float filteredValue, float thresholdPercent) {
+  if (thresholdPercent == 0.0f) return true;
+  if (fabsf(filteredValue) < 1e-6) return true;
+  float change = fabsf(value - filteredValue) / fabsf(filteredValue);
+  return change * 100.0f >= thresholdPercent;
+}
+
+// Hampel-Test: Abweichung vom gleitenden Median in Vielfachen der MAD.
+// MAD 0 (konstantes oder quantisiertes Fenster) gibt keine Streuung her: dann
+// wäre jede Abweichung um 1 LSB ein Ausreißer und echte Sprünge würden
+// verworfen, bis das halbe Fenster nachgezogen hat. Ohne Streuung kein Urteil.
+inline bool filterIsOutlier(const StreamingMAD& window, float madThreshold, float value) {
+  if (madThreshold <= 0.0f || window.size() < 3) return false;
+  float mad = window.mad();
+  if (mad <= 0.0f) return false;
+  return fabsf(value - window.median()) > madThreshold * mad;
+}
+
+inline float emaStep(float filteredValue, float value, float baseAlpha, float decayFactor) {
+  float effectiveAlpha = 1.0f - decayFactor * (1.0f - baseAlpha);
+  return effectiveAlpha * value + (1.0f - effectiveAlpha) * filteredValue;
+}
+
+// Skalarer Kalman-Schritt (Random-Walk-Modell), liefert den neuen Zustand x
+inline float kalmanStep(float& x, float& P, float Q, float R, float value) {
+  float K = P * (1.0f / (P + R));
+  x = x + K * (value - x);
+  P = (1.0f - K) * P + Q;
+  return x;
+}
+
+inline void kahanAdd(float& sum, float& compensation, float value) {
+  float y = value - compensation;
+  float t = sum + y;
+  compensation = (t - sum) - y;
+  sum = t;
+}
+
+// Linearphasiger Kern: coeffs[i] == coeffs[n-1-i] (auch für Q15-Tabellen)
+template <typename T>
+inline bool firIsSymmetric(const T* coeffs, size_t n) {
+  for (size_t i = 0; i < n / 2; ++i) {
+    if (coeffs[i] != coeffs[n - 1 - i]) return false;
+  }
+  return n >= 3;
+}
+
+// Summe coeffs[1..num-1] * hist[1..num-1] für symmetrische Koeffizienten: coeffs[num-1]
+// ist der Partner von coeffs[0], der Bereich 1..num-2 ist für sich symmetrisch und wird gefaltet
+inline float firFoldedPast(const float* coeffs, int num, const float* hist) {
+  int inner = num - 2;
+  int pairs = inner / 2;
+  float past = coeffs[num - 1] * hist[num - 1];
+  past += dspFoldedDot(coeffs + 1, hist + 1, hist + 1 + (inner - pairs), pairs);
+  if (inner & 1) past += coeffs[1 + pairs] * hist[1 + pairs];
+  return past;
+}
+
+// FIR über ein zusammenhängendes Fenster (neuester Wert zuerst) mit decayFactor:
+// Ältere Samples werden mit decayFactor gewichtet, fehlendes Gewicht geht an den neuesten,
+// bis zur Gleichanteil-Verstärkung des Kerns, höchstens 1 (Hoch-/Bandpass: 0).
+// pastCoeffSum = Summe coeffs[1..num-1], gilt bei voller Historie.
+// symmetric (firIsSymmetric()): bei voller Historie gefaltet, halb so viele Multiplikationen
+// (nur mit DSP_FOLD_SYMMETRIC, siehe DspKernels.h).
+inline float firDecayedOutput(const float* coeffs, int num, float pastCoeffSum, const float* hist, int histSize, float decayFactor,
+                              bool symmetric = false) {
+  if (histSize == 0) return 0.0f;
+  int n = num < histSize ? num : histSize;
+  float gain = coeffs[0] + pastCoeffSum;
+  float past;
+  if (n < num) {
+    past = dspDotProduct(coeffs + 1, hist + 1, n - 1);
+    pastCoeffSum = 0.0f;
+    for (int i = 1; i < n; ++i) pastCoeffSum += coeffs[i];
+  } else {
+    past = symmetric && DSP_FOLD_SYMMETRIC ? firFoldedPast(coeffs, num, hist) : dspDotProduct(coeffs + 1, hist + 1, n - 1);
+  }
+  float newest = hist[0];
+  float sumScaled = coeffs[0] + decayFactor * pastCoeffSum;
+  float output = coeffs[0] * newest + decayFactor * past;
+  float target = gain < 1.0f ? gain : 1.0f;
+  if (sumScaled < target) {
+    output += (target - sumScaled) * newest;
+  }
+  return output;
+}
+
+// SMA aus laufender Fenstersumme, entspricht firDecayedOutput() mit 1/capacity-Koeffizienten
+inline float smaDecayedOutput(float sum, float value, size_t capacity, size_t size, float decayFactor) {
+  float coeff = 1.0f / capacity;
+  float past = sum - value;
+  float sumScaled = coeff + decayFactor * coeff * (size - 1);
+  float output = coeff * value + decayFactor * coeff * past;
+  if (sumScaled < 1.0f) {
+    output += (1.0f - sumScaled) * value;
+  }
+  return output;
+}
+
+// LMS-Schrittweite, mit der MAD der Rohwerte normiert und auf 0.001..0.1 begrenzt
+inline float lmsStepSize(float mu, float mad) {
+  float dynamicMu = mu / (mad + 1e-6f);
+  return dynamicMu < 0.001f ? 0.001f : (dynamicMu > 0.1f ? 0.1f : dynamicMu);
+}
+
+// LMS-Prädiktion und Koeffizienten-Update; input neuester Wert zuerst (passend zu coeffs[0]).
+// Liefert die Prädiktion.
+inline float lmsStep(float* coeffs, const float* input, int length, float mu, float mad, float value) {
+  float dynamicMu = lmsStepSize(mu, mad);
+  float output = dspDotProduct(coeffs, input, length);
+  float error = value - output;
+  dspScaledAdd(coeffs, dynamicMu * error, input, length);
+  return output;
+}
+
+// P = RLS_INITIAL_P * I, length x length zeilenweise
+inline void rlsReset(float* P, int length) {
+  for (int i = 0; i < length * length; ++i) P[i] = 0.0f;
+  for (int i = 0; i < length; ++i) P[i * length + i] = RLS_INITIAL_P;
+}
+
+// RLS-Prädiktion und Update mit Vergessensfaktor lambda, O(length^2) ohne Heap.
+// P ist die symmetrische inverse Korrelationsmatrix (length x length, zeilenweise),
+// gain ein Arbeitspuffer mit length Einträgen; input neuester Wert zuerst.
+//   pi = P u, k = pi / (lambda + u' pi), w += k e, P = (P - k pi') / lambda
+// P wird nur im oberen Dreieck gerechnet und gespiegelt, damit es exakt
+// symmetrisch bleibt. Ohne Anregung (z. B. konstantes Signal) wächst P mit
+// 1/lambda; ab einer mittleren Diagonale von RLS_MAX_P wird daher nicht mehr
+// durch lambda geteilt. Liefert die Prädiktion.
+inline float rlsStep(float* coeffs, float* P, float* gain, const float* input, int length, float lambda, float value) {
+  float output = dspDotProduct(coeffs, input, length);
+  float error = value - output;
+
+  float denom = lambda;
+  for (int i = 0; i < length; ++i) {
+    gain[i] = dspDotProduct(P + i * length, input, length);
+    denom += input[i] * gain[i];
+  }
+  if (!(denom >= lambda)) {
+    // u' P u < 0: P hat durch Rundung die positive Definitheit verloren, neu starten
+    rlsReset(P, length);
+    return output;
+  }
+  float invDenom = 1.0f / denom;
+
+  float trace = 0.0f;
+  for (int i = 0; i < length; ++i) trace += P[i * length + i] - gain[i] * gain[i] * invDenom;
+  float scale = trace <= RLS_MAX_P * length * lambda ? 1.0f / lambda : 1.0f;
+
+  for (int i = 0; i < length; ++i) {
+    for (int j = i; j < length; ++j) {
+      float v = (P[i * length + j] - gain[i] * gain[j] * invDenom) * scale;
+      P[i * length + j] = v;
+      P[j * length + i] = v;
+    }
+  }
+  dspScaledAdd(coeffs, error * invDenom, gain, length);
+  return output;
+}
+
+// Biquad-Kaskade: numCoeffs ganze Sektionen {b0, b1, b2, a1, a2}, alle Pole im
+// Einheitskreis (Stabilitätsdreieck |a2| < 1, |a1| < 1 + a2). Rekursiv mit einem
+// return je Funktion, damit die Prüfung auch mit -std=gnu++11 constexpr bleibt.
+constexpr bool biquadPolesStable(float a1, float a2) {
+  return a2 < 1.0f && a2 > -1.0f && a1 < 1.0f + a2 && -a1 < 1.0f + a2;
+}
+
+constexpr bool biquadSectionsStable(const float* coeffs, int remaining) {
+  return remaining <= 0 || (biquadPolesStable(coeffs[3], coeffs[4]) &&
+                            biquadSectionsStable(coeffs + BIQUAD_SECTION_COEFFS, remaining - BIQUAD_SECTION_COEFFS));
+}
+
+constexpr bool biquadValid(const float* coeffs, int numCoeffs) {
+  return coeffs != nullptr && numCoeffs > 0 && numCoeffs % BIQUAD_SECTION_COEFFS == 0 &&
+         biquadSectionsStable(coeffs, numCoeffs);
+}
+
+// Gleichanteil-Verstärkung der Kaskade
+inline float biquadGain(const float* coeffs, int sections) {
+  float gain = 1.0f;
+  for (int s = 0; s < sections; ++s, coeffs += BIQUAD_SECTION_COEFFS) {
+    gain *= (coeffs[0] + coeffs[1] + coeffs[2]) / (1.0f + coeffs[3] + coeffs[4]); // Nenner > 0 bei stabilen Polen
+  }
+  return gain;
+}
+
+// Ein Sample durch die Kaskade, transponierte Direktform II (je Sektion
+// state s1, s2; 5 Multiplikationen):
+//   y = b0 x + s1, s1 = b1 x - a1 y + s2, s2 = b2 x - a2 y
+inline float biquadStep(const float* coeffs, float* state, int sections, float value) {
+  for (int s = 0; s < sections; ++s, coeffs += BIQUAD_SECTION_COEFFS, state += 2) {
+    float y = coeffs[0] * value + state[0];
+    state[0] = coeffs[1] * value - coeffs[3] * y + state[1];
+    state[1] = coeffs[2] * value - coeffs[4] * y;
+    value = y;
+  }
+  return value;
+}
+
+// Zustand zum eingeschwungenen Zustand für den konstanten Eingang value ziehen
+// (decayFactor 1 = unverändert, 0 = wie nach unendlich vielen Samples value)
+inline void biquadSettle(const float* coeffs, float* state, int sections, float value, float decayFactor) {
+  for (int s = 0; s < sections; ++s, coeffs += BIQUAD_SECTION_COEFFS, state += 2) {
+    float y = value * biquadGain(coeffs, 1);
+    float s2 = coeffs[2] * value - coeffs[4] * y;
+    float s1 = coeffs[1] * value - coeffs[3] * y + s2;
+    state[0] = s1 + decayFactor * (state[0] - s1);
+    state[1] = s2 + decayFactor * (state[1] - s2);
+    value = y;
+  }
+}
+
+// Kaskade mit decayFactor, gerechnet um den Arbeitspunkt offset: y = H(x - offset) + gain * offset.
+// Bei Polen nahe 1 (fc << fs) verstärkt die Rekursion Rundungsfehler um 1 / (1 + a1 + a2);
+// so wachsen sie mit der Abweichung vom Arbeitspunkt statt mit dem Absolutwert.
+// decayFactor 0 (Start, lange Lücke) setzt den Arbeitspunkt auf value, Ausgang gain * value.
+inline float biquadDecayedOutput(const float* coeffs, float* state, int sections, float gain, float& offset, float value,
+                                 float decayFactor) {
+  if (decayFactor <= 0.0f) {
+    offset = value;
+    for (int i = 0; i < 2 * sections; ++i) state[i] = 0.0f;
+  } else if (decayFactor < 1.0f) {
+    biquadSettle(coeffs, state, sections, value - offset, decayFactor);
+  }
+  float base = offset; // Lokal: state könnte offset aliasen
+  return biquadStep(coeffs, state, sections, value - base) + gain * base;
+}
+
+// Gespiegelter Ring wie HistoryRing: jeder Wert an head und head + length
+template <typename T>
+inline void mirroredRingPush(T* buffer, int& head, int length, T value) {
+  head = head == 0 ? length - 1 : head - 1;
+  buffer[head] = value;
+  buffer[head + length] = value;
+}
+
+#endif
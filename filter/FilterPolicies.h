@@ -0,0 +1,254 @@
+#ifndef FILTER_POLICIES_H
+#define FILTER_POLICIES_H
+
+#include <stddef.h>
+#include <array>
+#include "FilterMath.h"
+
+// Filteralgorithmen als Policy-Typen für FilterBank<...> (FilterBank.h).
+//
+// Jede Policy hält nur ihren eigenen Zustand in fester Größe (kein Heap) und
+// ist unabhängig von USE_KALMAN/USE_LMS/USE_RLS; Kalman, LMS und RLS lassen
+// sich also in einer Instanz mischen. Schnittstelle:
+//   static constexpr bool kUsesMad  Policy braucht die MAD der Rohwerte
+//   bool valid() const              Parameterprüfung für begin()
+//   void reset()                    Zustand wie nach initFilter()
+//   float update(const FilterStep&) neuer gefilterter Wert
+// Die Rechnung entspricht DynamicAdaptiveFilterV2 (gemeinsam über FilterMath.h).
+
+#ifndef SMA_RESYNC_INTERVAL
+#define SMA_RESYNC_INTERVAL 1024 // SMA: Laufende Summe alle n Samples neu berechnen
+#endif
+
+// Eingabe eines Filterschritts
+struct FilterStep {
+  float value;               // Rohwert
+  float filteredValue;       // Bisheriger Ausgang des Kanals
+  float decayFactor;         // 1 = regulär, 0 = Historie verworfen
+  const StreamingMAD& mad;   // Fenster der Hampel-Vorstufe (leer, wenn nicht genutzt)
+};
+
+// Exponential Moving Average
+class Ema {
+public:
+  static constexpr bool kUsesMad = false;
+
+  explicit Ema(int length = 10) : _length(length), _baseAlpha(0.0f) { reset(); }
+  bool valid() const { return _length >= 1; }
+  void reset() { _baseAlpha = 2.0f / ((_length < 1 ? 1 : _length) + 1.0f); }
+  float update(const FilterStep& step) {
+    return emaStep(step.filteredValue, step.value, _baseAlpha, step.decayFactor);
+  }
+
+private:
+  int _length;
+  float _baseAlpha;
+};
+
+// Simple Moving Average über N Samples, laufende Summe wie updateSMA()
+template <size_t N>
+class Sma {
+  static_assert(N >= 1, "Sma<N>: N >= 1");
+
+public:
+  static constexpr bool kUsesMad = false;
+
+  Sma() { reset(); }
+  bool valid() const { return true; }
+  void reset() {
+    _buf.fill(0.0f);
+    _head = 0;
+    _count = 0;
+    _sum = 0.0f;
+    _compensation = 0.0f;
+    _pushCount = 0;
+  }
+  float update(const FilterStep& step) {
+    if (_count == N) {
+      kahanAdd(_sum, _compensation, -_buf[_head + N - 1]);
+    }
+    _head = _head == 0 ? N - 1 : _head - 1;
+    _buf[_head] = step.value;
+    _buf[_head + N] = step.value;
+    if (_count < N) _count++;
+    kahanAdd(_sum, _compensation, step.value);
+    if (++_pushCount >= SMA_RESYNC_INTERVAL) {
+      resync();
+    }
+    return smaDecayedOutput(_sum, step.value, N, _count, step.decayFactor);
+  }
+
+private:
+  std::array<float, 2 * N> _buf; // Gespiegelter Ring, neuester Wert ab _head
+  size_t _head;
+  size_t _count;
+  float _sum;
+  float _compensation;
+  unsigned int _pushCount;
+
+  void resync() {
+    _sum = 0.0f;
+    _compensation = 0.0f;
+    for (size_t i = 0; i < _count; ++i) kahanAdd(_sum, _compensation, _buf[_head + i]);
+    _pushCount = 0;
+  }
+};
+
+// FIR mit N Koeffizienten (coeffs[0] gewichtet den neuesten Wert)
+template <size_t N>
+class Fir {
+  static_assert(N >= 1, "Fir<N>: N >= 1");
+
+public:
+  static constexpr bool kUsesMad = false;
+
+  explicit Fir(const float (&coeffs)[N]) {
+    for (size_t i = 0; i < N; ++i) _coeffs[i] = coeffs[i];
+    reset();
+  }
+  explicit Fir(const std::array<float, N>& coeffs) : _coeffs(coeffs) { reset(); }
+  bool valid() const { return true; }
+  void reset() {
+    _hist.fill(0.0f);
+    _head = 0;
+    _count = 0;
+    _pastCoeffSum = 0.0f;
+    for (size_t i = 1; i < N; ++i) _pastCoeffSum += _coeffs[i];
+    _symmetric = firIsSymmetric(_coeffs.data(), N);
+  }
+  float update(const FilterStep& step) {
+    _head = _head == 0 ? N - 1 : _head - 1;
+    _hist[_head] = step.value;
+    _hist[_head + N] = step.value;
+    if (_count < N) _count++;
+    return firDecayedOutput(_coeffs.data(), static_cast<int>(N), _pastCoeffSum, _hist.data() + _head,
+                            static_cast<int>(_count), step.decayFactor, _symmetric);
+  }
+  const std::array<float, N>& coeffs() const { return _coeffs; }
+
+private:
+  std::array<float, N> _coeffs;
+  std::array<float, 2 * N> _hist; // Gespiegelter Ring, neuester Wert ab _head
+  size_t _head;
+  size_t _count;
+  float _pastCoeffSum;
+  bool _symmetric;
+};
+
+// IIR-Kaskade aus Sections Sektionen zweiter Ordnung (Entwurf per BiquadDesign.h),
+// eingeschwungen mit dem ersten Sample wie updateBiquad()
+template <size_t Sections>
+class Biquad {
+  static_assert(Sections >= 1, "Biquad<Sections>: Sections >= 1");
+
+public:
+  static constexpr bool kUsesMad = false;
+
+  explicit Biquad(const std::array<float, BIQUAD_SECTION_COEFFS * Sections>& coeffs) : _coeffs(coeffs) { reset(); }
+  bool valid() const { return biquadValid(_coeffs.data(), static_cast<int>(_coeffs.size())); }
+  void reset() {
+    _state.fill(0.0f);
+    _offset = 0.0f;
+    _gain = biquadGain(_coeffs.data(), static_cast<int>(Sections));
+    _primed = false;
+  }
+  float update(const FilterStep& step) {
+    float decay = _primed ? step.decayFactor : 0.0f;
+    _primed = true;
+    return biquadDecayedOutput(_coeffs.data(), _state.data(), static_cast<int>(Sections), _gain, _offset, step.value, decay);
+  }
+  const std::array<float, BIQUAD_SECTION_COEFFS * Sections>& coeffs() const { return _coeffs; }
+
+private:
+  std::array<float, BIQUAD_SECTION_COEFFS * Sections> _coeffs;
+  std::array<float, 2 * Sections> _state; // s1, s2 je Sektion, relativ zu _offset
+  float _offset;
+  float _gain;
+  bool _primed;
+};
+
+// Skalarer Kalman-Filter (Random-Walk-Modell)
+class Kalman {
+public:
+  static constexpr bool kUsesMad = false;
+
+  Kalman(float Q, float R, float initialState = 0.0f) : _Q(Q), _R(R), _initialState(initialState) { reset(); }
+  bool valid() const { return _Q > 0 && _R > 0; }
+  void reset() {
+    _x = _initialState;
+    _P = 1.0f;
+  }
+  float update(const FilterStep& step) { return kalmanStep(_x, _P, _Q, _R, step.value); }
+  float state() const { return _x; }
+  float covariance() const { return _P; }
+
+private:
+  float _Q;
+  float _R;
+  float _initialState;
+  float _x;
+  float _P;
+};
+
+// LMS-Prädiktor mit N Koeffizienten, Schrittweite über die MAD normiert
+template <size_t N>
+class Lms {
+  static_assert(N >= 1, "Lms<N>: N >= 1");
+
+public:
+  static constexpr bool kUsesMad = true;
+
+  explicit Lms(float mu) : _mu(mu) { reset(); }
+  bool valid() const { return _mu > 0; }
+  void reset() {
+    _coeffs.fill(0.0f);
+    _input.fill(0.0f);
+    _head = 0;
+  }
+  float update(const FilterStep& step) {
+    float output = lmsStep(_coeffs.data(), _input.data() + _head, static_cast<int>(N), _mu, step.mad.mad(), step.value);
+    mirroredRingPush(_input.data(), _head, static_cast<int>(N), step.value);
+    return output;
+  }
+  const std::array<float, N>& coeffs() const { return _coeffs; }
+
+private:
+  float _mu;
+  std::array<float, N> _coeffs;
+  std::array<float, 2 * N> _input; // Gespiegelter Ring, neuester Wert ab _head
+  int _head;
+};
+
+// RLS-Prädiktor mit N Koeffizienten und Vergessensfaktor lambda, O(N^2) pro Sample
+template <size_t N>
+class Rls {
+  static_assert(N >= 1, "Rls<N>: N >= 1");
+
+public:
+  static constexpr bool kUsesMad = false;
+
+  explicit Rls(float lambda) : _lambda(lambda) { reset(); }
+  bool valid() const { return _lambda > 0 && _lambda <= 1; }
+  void reset() {
+    _coeffs.fill(0.0f);
+    _input.fill(0.0f);
+    _head = 0;
+    rlsReset(_P.data(), static_cast<int>(N));
+  }
+  float update(const FilterStep& step) {
+    std::array<float, N> gain;
+    float output = rlsStep(_coeffs.data(), _P.data(), gain.data(), _input.data() + _head, static_cast<int>(N), _lambda, step.value);
+    mirroredRingPush(_input.data(), _head, static_cast<int>(N), step.value);
+    return output;
+  }
+  const std::array<float, N>& coeffs() const { return _coeffs; }
+
+private:
+  float _lambda;
+  std::array<float, N> _coeffs;
+  std::array<float, 2 * N> _input; // Gespiegelter Ring, neuester Wert ab _head
+  int _head;
+  std::array<float, N * N> _P;     // Inverse Korrelationsmatrix, zeilenweise
+};
+
+#endif
@@ -0,0 +1,222 @@
+#ifndef FIR_DESIGN_H
+#define FIR_DESIGN_H
+
+#include <stddef.h>
+
+// FIR-Entwurf zur Compile-Zeit: gefensterter Sinc mit Kaiser-Fenster.
+//
+//   constexpr auto lp = firLowPass<31>(100.0f, 5.0f);          // fs = 100 Hz, fc = 5 Hz
+//   constexpr auto notch = firNotch<61>(200.0f, 50.0f, 20.0f);   // 50 Hz: -65 dB, 40/60 Hz: -6 dB
+//   FilterConfig c = {FIR, 0, lp.data(), lp.size(), 100.0f, 3600000, 2000, 0.0f, 0.0f, VALUE_MODE};
+//
+// Ergebnis ist ein constexpr DesignArray<float, N> im Flash, ohne Rechnung zur
+// Laufzeit. Alle Kerne sind symmetrisch (linearphasig, Verzögerung (N-1)/2
+// Samples); der Filter erkennt das und rechnet gefaltet (firDecayedOutput()).
+// Normiert auf Verstärkung 1 im Durchlassbereich: Tiefpass und Bandsperre bei
+// 0 Hz, Hochpass bei fs/2, Bandpass in der Bandmitte.
+// Angegebene Grenzfrequenzen sind die -6-dB-Punkte. attenuationDb bestimmt das
+// Kaiser-beta (Sperrdämpfung gegen Breite des Übergangs); firKaiserTaps()
+// schätzt die dafür nötige Länge. Ist der Übergang breiter als ein Sperr- oder
+// Durchlassband, wird dieses nicht erreicht (zu wenige Taps).
+// Ungültige Frequenzen brechen die Compile-Zeit-Auswertung ab (Aufruf von
+// firInvalidDesign()).
+
+#define FIR_DEFAULT_ATTENUATION_DB 60.0f
+
+// Feld fester Länge für die Entwürfe, Zugriff wie std::array (data(), size(),
+// operator[], begin()/end()). std::array erlaubt Schreiben und data() in
+// constexpr erst ab C++17, DesignArray schon ab C++14.
+template <typename T, size_t N>
+struct DesignArray {
+  T values[N];
+
+  constexpr T& operator[](size_t i) { return values[i]; }
+  constexpr const T& operator[](size_t i) const { return values[i]; }
+  constexpr T* data() { return values; }
+  constexpr const T* data() const { return values; }
+  static constexpr size_t size() { return N; }
+  constexpr T* begin() { return values; }
+  constexpr const T* begin() const { return values; }
+  constexpr T* end() { return values + N; }
+  constexpr const T* end() const { return values + N; }
+};
+
+// --- constexpr-Mathematik (double, da std::sin & Co. nicht constexpr sind) ---
+
+constexpr double firPi = 3.14159265358979323846;
+
+// Nicht constexpr: macht eine Compile-Zeit-Auswertung mit ungültigen Parametern zum Fehler
+inline double firInvalidDesign() { return 0.0; }
+
+constexpr double firAbs(double x) { return x < 0.0 ? -x : x; }
+
+constexpr double firSin(double x) {
+  // Auf [-pi, pi] reduzieren, dann Taylor-Reihe bis zur Maschinengenauigkeit
+  double turns = x / (2.0 * firPi);
+  long long k = static_cast<long long>(turns < 0.0 ? turns - 0.5 : turns + 0.5);
+  x -= static_cast<double>(k) * 2.0 * firPi;
+  double term = x;
+  double sum = x;
+  for (int i = 1; i < 30 && firAbs(term) > 1e-17; ++i) {
+    term *= -x * x / ((2.0 * i) * (2.0 * i + 1.0));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double firCos(double x) { return firSin(x + 0.5 * firPi); }
+
+constexpr double firSqrt(double x) {
+  if (x <= 0.0) return 0.0;
+  double r = x > 1.0 ? x : 1.0;
+  for (int i = 0; i < 100; ++i) {
+    double next = 0.5 * (r + x / r);
+    if (next == r) break;
+    r = next;
+  }
+  return r;
+}
+
+// n-te Wurzel (x > 0) per Newton, für die Kaiser-Formeln
+constexpr double firRoot(double x, int n) {
+  if (x <= 0.0) return 0.0;
+  double r = x > 1.0 ? x : 1.0;
+  for (int i = 0; i < 200; ++i) {
+    double p = 1.0;
+    for (int j = 0; j < n - 1; ++j) p *= r;
+    double next = r - (p * r - x) / (n * p);
+    if (firAbs(next - r) <= 1e-15 * r) return next;
+    r = next;
+  }
+  return r;
+}
+
+// Modifizierte Bessel-Funktion erster Art, Ordnung 0
+constexpr double firBesselI0(double x) {
+  double half = 0.5 * x;
+  double term = 1.0;
+  double sum = 1.0;
+  for (int k = 1; k < 100; ++k) {
+    term *= (half / k) * (half / k);
+    sum += term;
+    if (term < 1e-16 * sum) break;
+  }
+  return sum;
+}
+
+// sin(pi x) / (pi x)
+constexpr double firSinc(double x) { return x == 0.0 ? 1.0 : firSin(firPi * x) / (firPi * x); }
+
+// --- Kaiser-Fenster ----------------------------------------------------------
+
+// beta für die gewünschte Sperrdämpfung (Kaiser 1974)
+constexpr double firKaiserBeta(double attenuationDb) {
+  return attenuationDb > 50.0 ? 0.1102 * (attenuationDb - 8.7)
+       : attenuationDb >= 21.0 ? 0.5842 * firRoot((attenuationDb - 21.0) * (attenuationDb - 21.0), 5) + 0.07886 * (attenuationDb - 21.0)
+       : 0.0;
+}
+
+// Geschätzte Tap-Zahl für Sperrdämpfung und Übergangsbreite, ungerade (für alle Entwürfe gültig)
+constexpr size_t firKaiserTaps(double attenuationDb, double transitionHz, double sampleRateHz) {
+  double taps = (attenuationDb - 7.95) / (14.36 * transitionHz / sampleRateHz) + 1.0;
+  size_t n = static_cast<size_t>(taps) + 1;
+  return n | 1;
+}
+
+constexpr double firKaiserWindow(size_t i, size_t n, double beta) {
+  if (n == 1) return 1.0;
+  double r = 2.0 * static_cast<double>(i) / static_cast<double>(n - 1) - 1.0;
+  return firBesselI0(beta * firSqrt(1.0 - r * r)) / firBesselI0(beta);
+}
+
+// --- Entwurf -----------------------------------------------------------------
+
+// Gefensterter idealer Tiefpass mit Grenzfrequenz fc (Anteil von fs), nicht normiert
+template <size_t N>
+constexpr DesignArray<double, N> firWindowedSinc(double fc, double beta) {
+  DesignArray<double, N> h{};
+  double center = 0.5 * static_cast<double>(N - 1);
+  for (size_t i = 0; i < N; ++i) {
+    h[i] = 2.0 * fc * firSinc(2.0 * fc * (static_cast<double>(i) - center)) * firKaiserWindow(i, N, beta);
+  }
+  return h;
+}
+
+// Verstärkung bei f (Anteil von fs); reell, da der Kern symmetrisch ist
+template <size_t N>
+constexpr double firGainAt(const DesignArray<double, N>& h, double f) {
+  double center = 0.5 * static_cast<double>(N - 1);
+  double sum = 0.0;
+  for (size_t i = 0; i < N; ++i) sum += h[i] * firCos(2.0 * firPi * f * (static_cast<double>(i) - center));
+  return sum;
+}
+
+template <size_t N>
+constexpr DesignArray<float, N> firNormalized(const DesignArray<double, N>& h, double gain) {
+  DesignArray<float, N> out{};
+  if (gain == 0.0) gain = firInvalidDesign();
+  for (size_t i = 0; i < N; ++i) out[i] = static_cast<float>(h[i] / gain);
+  // Exakt symmetrisch, auch nach Rundung (Voraussetzung für den gefalteten Pfad)
+  for (size_t i = 0; i < N / 2; ++i) out[N - 1 - i] = out[i];
+  return out;
+}
+
+constexpr double firCheckedFraction(double hz, double sampleRateHz) {
+  return hz > 0.0 && hz < 0.5 * sampleRateHz ? hz / sampleRateHz : firInvalidDesign();
+}
+
+template <size_t N>
+constexpr DesignArray<float, N> firLowPass(float sampleRateHz, float cutoffHz, float attenuationDb = FIR_DEFAULT_ATTENUATION_DB) {
+  static_assert(N >= 1, "firLowPass: N >= 1");
+  DesignArray<double, N> h = firWindowedSinc<N>(firCheckedFraction(cutoffHz, sampleRateHz), firKaiserBeta(attenuationDb));
+  return firNormalized(h, firGainAt(h, 0.0));
+}
+
+// Spektrale Inversion des Tiefpasses; N ungerade, sonst hat der Kern bei fs/2 eine Nullstelle
+template <size_t N>
+constexpr DesignArray<float, N> firHighPass(float sampleRateHz, float cutoffHz, float attenuationDb = FIR_DEFAULT_ATTENUATION_DB) {
+  static_assert(N % 2 == 1, "firHighPass: N ungerade");
+  DesignArray<double, N> h = firWindowedSinc<N>(firCheckedFraction(cutoffHz, sampleRateHz), firKaiserBeta(attenuationDb));
+  for (size_t i = 0; i < N; ++i) h[i] = -h[i];
+  h[N / 2] += 1.0; // Fensterwert in der Mitte ist 1
+  return firNormalized(h, firGainAt(h, 0.5));
+}
+
+// Differenz zweier Tiefpässe
+template <size_t N>
+constexpr DesignArray<double, N> firBandKernel(double low, double high, double beta) {
+  DesignArray<double, N> h = firWindowedSinc<N>(high, beta);
+  DesignArray<double, N> l = firWindowedSinc<N>(low, beta);
+  for (size_t i = 0; i < N; ++i) h[i] -= l[i];
+  return h;
+}
+
+template <size_t N>
+constexpr DesignArray<float, N> firBandPass(float sampleRateHz, float lowHz, float highHz, float attenuationDb = FIR_DEFAULT_ATTENUATION_DB) {
+  static_assert(N >= 3, "firBandPass: N >= 3");
+  double low = firCheckedFraction(lowHz, sampleRateHz);
+  double high = lowHz < highHz ? firCheckedFraction(highHz, sampleRateHz) : firInvalidDesign();
+  DesignArray<double, N> h = firBandKernel<N>(low, high, firKaiserBeta(attenuationDb));
+  return firNormalized(h, firGainAt(h, 0.5 * (low + high)));
+}
+
+// Einheitsimpuls minus Bandpass; N ungerade
+template <size_t N>
+constexpr DesignArray<float, N> firBandStop(float sampleRateHz, float lowHz, float highHz, float attenuationDb = FIR_DEFAULT_ATTENUATION_DB) {
+  static_assert(N % 2 == 1, "firBandStop: N ungerade");
+  double beta = firKaiserBeta(attenuationDb);
+  double low = firCheckedFraction(lowHz, sampleRateHz);
+  double high = lowHz < highHz ? firCheckedFraction(highHz, sampleRateHz) : firInvalidDesign();
+  DesignArray<double, N> h = firBandKernel<N>(low, high, beta);
+  for (size_t i = 0; i < N; ++i) h[i] = -h[i];
+  h[N / 2] += 1.0;
+  return firNormalized(h, firGainAt(h, 0.0));
+}
+
+// Sperrt centerHz ± widthHz / 2 (z. B. Netzbrummen)
+template <size_t N>
+constexpr DesignArray<float, N> firNotch(float sampleRateHz, float centerHz, float widthHz, float attenuationDb = FIR_DEFAULT_ATTENUATION_DB) {
+  return firBandStop<N>(sampleRateHz, centerHz - 0.5f * widthHz, centerHz + 0.5f * widthHz, attenuationDb);
+}
+
+#endif
@@ -0,0 +1,183 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+// Festkomma-Arithmetik für den DAF_FIXED_POINT-Build (MCUs ohne FPU, z. B. ESP32-C3/C6).
+//
+// Q15: int16_t, Bereich [-1, 1), 1 LSB = 2^-15 (FIR-Koeffizienten)
+// Q31: int32_t, Bereich [-1, 1), 1 LSB = 2^-31 (Signal und Filterzustand)
+// decayFactor: uint32_t mit 31 Nachkommabits, Q31_ONE = 1
+// Produkte werden in 64 Bit gebildet und gerundet zurückgeschoben, Ergebnisse
+// sättigen statt überzulaufen. Die Rechenschritte entsprechen FilterMath.h.
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define Q15_ONE 32768 // 1.0 in Q15, nur in 32/64-Bit-Zwischenwerten darstellbar
+#define Q31_ONE (1UL << 31) // 1.0 für den decayFactor (uint32_t)
+#define Q24_ONE (1UL << 24) // 1.0 in UQ8.24 (Kalman-Kovarianz)
+
+constexpr q31_t q31Saturate(int64_t value) {
+  return value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : static_cast<q31_t>(value));
+}
+
+constexpr q15_t q15Saturate(int32_t value) {
+  return value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : static_cast<q15_t>(value));
+}
+
+// Gerundet und gesättigt; constexpr, damit Tabellen zur Compile-Zeit umgerechnet werden
+constexpr q15_t floatToQ15(float value) {
+  return value != value ? 0
+       : value >= 1.0f ? INT16_MAX
+       : value < -1.0f ? INT16_MIN
+       : q15Saturate(static_cast<int32_t>(value * 32768.0f + (value >= 0.0f ? 0.5f : -0.5f)));
+}
+
+constexpr q31_t floatToQ31(float value) {
+  return value != value ? 0
+       : value >= 1.0f ? INT32_MAX
+       : value < -1.0f ? INT32_MIN
+       : q31Saturate(static_cast<int64_t>(value * 2147483648.0f));
+}
+
+constexpr float q15ToFloat(int32_t value) { return static_cast<float>(value) * (1.0f / 32768.0f); }
+constexpr float q31ToFloat(q31_t value) { return static_cast<float>(value) * (1.0f / 2147483648.0f); }
+constexpr float decayToFloat(uint32_t decayFactor) { return static_cast<float>(decayFactor) * (1.0f / 2147483648.0f); }
+
+// Vorzeichenlos mit 8 Vorkomma- und 24 Nachkommabits, sättigt bei 256
+constexpr uint32_t floatToUQ24(float value) {
+  return value != value || value <= 0.0f ? 0
+       : value >= 256.0f ? UINT32_MAX
+       : static_cast<uint32_t>(value * 16777216.0f + 0.5f);
+}
+
+// Vorzeichenbehaftet mit 16 Vorkomma- und 16 Nachkommabits (LMS-Schrittweite)
+constexpr int32_t floatToQ16(float value) {
+  return value != value ? 0
+       : value >= 32768.0f ? INT32_MAX
+       : value < -32768.0f ? INT32_MIN
+       : static_cast<int32_t>(value * 65536.0f);
+}
+
+inline q31_t q31Add(q31_t a, q31_t b) { return q31Saturate(static_cast<int64_t>(a) + b); }
+inline q31_t q31Sub(q31_t a, q31_t b) { return q31Saturate(static_cast<int64_t>(a) - b); }
+inline q31_t q31Mul(q31_t a, q31_t b) {
+  return q31Saturate((static_cast<int64_t>(a) * b + (1LL << 30)) >> 31);
+}
+
+// FIR-Tabelle (z. B. aus FIR_coefficients.h) zur Compile-Zeit nach Q15
+template <size_t N>
+constexpr std::array<q15_t, N> toQ15Table(const float (&table)[N]) {
+  std::array<q15_t, N> out{};
+  for (size_t i = 0; i < N; ++i) out[i] = floatToQ15(table[i]);
+  return out;
+}
+
+// Dasselbe für entworfene Tabellen (FirDesign.h)
+template <size_t N>
+constexpr std::array<q15_t, N> toQ15Table(const std::array<float, N>& table) {
+  std::array<q15_t, N> out{};
+  for (size_t i = 0; i < N; ++i) out[i] = floatToQ15(table[i]);
+  return out;
+}
+
+// decayFactor wie filterDecayFactor(), 31 Nachkommabits (Q31_ONE = 1), nur Ganzzahl-Division
+inline uint32_t fixedDecayFactor(unsigned long deltaT, unsigned long expectedIntervalMs, unsigned long maxDecayTimeMs) {
+  if (deltaT <= expectedIntervalMs) {
+    return Q31_ONE;
+  } else if (deltaT >= maxDecayTimeMs) {
+    return 0;
+  }
+  return static_cast<uint32_t>((static_cast<uint64_t>(maxDecayTimeMs - deltaT) << 31) / (maxDecayTimeMs - expectedIntervalMs));
+}
+
+// a * decayFactor für 64-Bit-Werte, in zwei Teilprodukten ohne Überlauf
+inline int64_t mulDecay(int64_t a, uint32_t decayFactor) {
+  return (a >> 31) * decayFactor + (((a & 0x7FFFFFFFLL) * decayFactor) >> 31);
+}
+
+// EMA als filtered + alpha * (value - filtered); alpha = 1 - decayFactor * (1 - baseAlpha)
+inline q31_t emaStepQ31(q31_t filteredValue, q31_t value, q31_t baseAlpha, uint32_t decayFactor) {
+  int64_t oneMinusAlpha = (1LL << 31) - baseAlpha;
+  int64_t effectiveAlpha = (1LL << 31) - ((oneMinusAlpha * decayFactor) >> 31);
+  int64_t diff = static_cast<int64_t>(value) - filteredValue;
+  return q31Saturate(filteredValue + ((effectiveAlpha * diff + (1LL << 30)) >> 31));
+}
+
+// SMA aus exakter 64-Bit-Fenstersumme, entspricht smaDecayedOutput()
+// (Zähler mit capacity multipliziert: value + d * past + (capacity - 1 - d * (size - 1)) * value)
+inline q31_t smaDecayedOutputQ31(int64_t sum, q31_t value, size_t capacity, size_t size, uint32_t decayFactor) {
+  int64_t past = sum - value;
+  int64_t output = value + mulDecay(past, decayFactor);
+  int64_t weight = static_cast<int64_t>(Q31_ONE) + static_cast<int64_t>(decayFactor) * static_cast<int64_t>(size - 1);
+  if (weight < (static_cast<int64_t>(capacity) << 31)) {
+    output += static_cast<int64_t>(value) * static_cast<int64_t>(capacity - 1) - mulDecay(static_cast<int64_t>(value) * static_cast<int64_t>(size - 1), decayFactor);
+  }
+  return q31Saturate(output / static_cast<int64_t>(capacity));
+}
+
+// Gefaltete Vergangenheit wie firFoldedPast(); ganzzahlig exakt, also bitgleich zum Skalarprodukt
+inline int64_t firFoldedPastQ31(const q15_t* coeffs, int num, const q31_t* hist) {
+  int64_t past = static_cast<int64_t>(coeffs[num - 1]) * hist[num - 1];
+  int lo = 1;
+  int hi = num - 2;
+  for (; lo < hi; ++lo, --hi) past += static_cast<int64_t>(coeffs[lo]) * (static_cast<int64_t>(hist[lo]) + hist[hi]);
+  if (lo == hi) past += static_cast<int64_t>(coeffs[lo]) * hist[lo];
+  return past;
+}
+
+// FIR mit Q15-Koeffizienten über Q31-Historie (neuester Wert zuerst), entspricht firDecayedOutput()
+inline q31_t firDecayedOutputQ31(const q15_t* coeffs, int num, int32_t pastCoeffSum, const q31_t* hist, int histSize, uint32_t decayFactor,
+                                 bool symmetric = false) {
+  if (histSize == 0) return 0;
+  int n = num < histSize ? num : histSize;
+  int64_t gain = coeffs[0] + pastCoeffSum;
+  int64_t past = 0; // Q46
+  if (n < num) {
+    for (int i = 1; i < n; ++i) past += static_cast<int64_t>(coeffs[i]) * hist[i];
+    pastCoeffSum = 0;
+    for (int i = 1; i < n; ++i) pastCoeffSum += coeffs[i];
+  } else if (symmetric) {
+    past = firFoldedPastQ31(coeffs, num, hist);
+  } else {
+    for (int i = 1; i < n; ++i) past += static_cast<int64_t>(coeffs[i]) * hist[i];
+  }
+  int64_t newest = hist[0];
+  int64_t sumScaled = coeffs[0] + ((static_cast<int64_t>(decayFactor) * pastCoeffSum) >> 31);
+  int64_t output = coeffs[0] * newest + mulDecay(past, decayFactor);
+  int64_t target = gain < Q15_ONE ? gain : Q15_ONE;
+  if (sumScaled < target) {
+    output += (target - sumScaled) * newest;
+  }
+  return q31Saturate((output + (1LL << 14)) >> 15);
+}
+
+// Skalarer Kalman-Schritt mit auf R normierter Kovarianz (p = P/R, q = Q/R in UQ8.24),
+// dadurch unabhängig vom Vollausschlag: K = p / (p + 1), p' = (1 - K) p + q
+inline q31_t kalmanStepQ31(q31_t& x, uint32_t& p, uint32_t q, q31_t value) {
+  uint64_t K = (static_cast<uint64_t>(p) << 31) / (static_cast<uint64_t>(p) + Q24_ONE); // Q31
+  int64_t diff = static_cast<int64_t>(value) - x;
+  x = q31Saturate(x + ((static_cast<int64_t>(K) * diff + (1LL << 30)) >> 31));
+  uint64_t pNext = ((((1ULL << 31) - K) * p) >> 31) + q;
+  p = pNext > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(pNext);
+  return x;
+}
+
+// LMS-Prädiktion und Update mit Q28-Koeffizienten (Bereich ±8) über Q31-Eingang,
+// step = Schrittweite im Q31-Wertebereich (Q16.16). Entspricht lmsStep().
+inline q31_t lmsStepQ31(int32_t* coeffs, const q31_t* input, int length, int32_t step, q31_t value) {
+  int64_t acc = 0;
+  for (int i = 0; i < length; ++i) acc += static_cast<int64_t>(coeffs[i]) * input[i];
+  q31_t output = q31Saturate(acc >> 28);
+  int64_t error = q31Sub(value, output);
+  for (int i = 0; i < length; ++i) {
+    int64_t product = (error * input[i]) >> 31;
+    coeffs[i] = q31Saturate(coeffs[i] + ((product * step) >> 19));
+  }
+  return output;
+}
+
+#endif
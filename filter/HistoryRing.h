@@ -0,0 +1,93 @@
+#ifndef HISTORY_RING_H
+#define HISTORY_RING_H
+
+#include <stddef.h>
+#include <vector>
+
+// Ringpuffer fester Kapazität für die SMA/FIR-Historie.
+//
+// Jeder Wert wird doppelt abgelegt (Position head und head + capacity),
+// der Kopf läuft rückwärts. Dadurch liegt das Fenster immer zusammenhängend
+// und neuester Wert zuerst im Speicher: newestFirst()[0] ist das neueste
+// Sample, newestFirst()[i] das i-te ältere. So passt das Fenster direkt zur
+// Reihenfolge der FIR-Koeffizienten (coeffs[0] gewichtet den neuesten Wert),
+// ohne Modulo-Index, ohne memmove und ohne Heap-Zugriff nach reset().
+// HistoryRing speichert float, der DAF_FIXED_POINT-Build nutzt BasicHistoryRing<q31_t>.
+template <typename T>
+class BasicHistoryRing {
+public:
+  BasicHistoryRing() : _capacity(0), _head(0), _count(0) {}
+
+  // Einmalige Allokation; bei gleicher Kapazität wird nichts neu angelegt
+  void reset(size_t capacity) {
+    _capacity = capacity;
+    _buf.assign(2 * capacity, T());
+    _head = 0;
+    _count = 0;
+  }
+
+  void clear() {
+    _head = 0;
+    _count = 0;
+  }
+
+  void push(T value) {
+    if (_capacity == 0) return;
+    _head = _head == 0 ? _capacity - 1 : _head - 1;
+    _buf[_head] = value;
+    _buf[_head + _capacity] = value;
+    if (_count < _capacity) _count++;
+  }
+
+  void fill(T value) {
+    for (size_t i = 0; i < _buf.size(); ++i) _buf[i] = value;
+    _head = 0;
+    _count = _capacity;
+  }
+
+  size_t size() const { return _count; }
+  size_t capacity() const { return _capacity; }
+  bool full() const { return _count == _capacity; }
+  bool empty() const { return _count == 0; }
+
+  // Snapshot (filter/Snapshot.h): Kapazität und gültige Werte, neuester zuerst
+  template <typename Archive>
+  void save(Archive& out) const {
+    out.u32(_capacity);
+    out.u32(_count);
+    out.array(newestFirst(), _count);
+  }
+
+  // Übernimmt die gespeicherte Kapazität (z. B. nach updateLength())
+  template <typename Archive>
+  void restore(Archive& in) {
+    size_t capacity = 0;
+    size_t count = 0;
+    in.u32(capacity);
+    in.u32(count);
+    if (count > capacity || count * sizeof(T) > in.remaining()) {
+      in.fail();
+      return;
+    }
+    if (capacity != _capacity) reset(capacity);
+    in.array(_buf.data(), count);
+    for (size_t i = 0; i < count; ++i) _buf[i + capacity] = _buf[i];
+    _head = 0;
+    _count = count;
+  }
+
+  // Zusammenhängendes Fenster, neuester Wert zuerst (size() gültige Einträge)
+  const T* newestFirst() const { return _buf.data() + _head; }
+  T newest() const { return _buf[_head]; }
+  T oldest() const { return _buf[_head + _count - 1]; }
+
+private:
+  std::vector<T> _buf;
+  size_t _capacity;
+  size_t _head;
+  size_t _count;
+};
+
+typedef BasicHistoryRing<float> HistoryRing;
+
+#endif
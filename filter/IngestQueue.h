@@ -0,0 +1,166 @@
+#ifndef INGEST_QUEUE_H
+#define INGEST_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Lock-freie Warteschlangen fester Kapazität für ISRs und den zweiten ESP32-Kern.
+//
+// SpscQueue: genau ein Produzent, genau ein Konsument. Nur Load/Store mit
+// acquire/release, kein Read-Modify-Write -> auch in ISRs ohne Atomic-Befehle.
+// MpscQueue: beliebig viele Produzenten, ein Konsument (gebundene Queue nach
+// D. Vyukov). Jede Zelle trägt eine Sequenznummer; ein Produzent reserviert
+// per CAS auf _tail und gibt die Zelle nach dem Schreiben über seq frei.
+// Der Konsument sieht ein Element erst, wenn es vollständig geschrieben ist,
+// dadurch keine zerrissenen Einträge.
+// Beide Queues verwerfen bei voller Queue (push() == false) und zählen das in dropped().
+// pushBatch() reiht n Elemente mit einer einzigen Reservierung ein, ganz oder gar nicht.
+// Capacity muss eine Zweierpotenz sein; Indizes laufen als uint32_t über.
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity muss eine Zweierpotenz sein");
+
+public:
+  SpscQueue() : _head(0), _tail(0), _dropped(0) {}
+
+  // Nur vom Produzenten
+  bool push(const T& item) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head.load(std::memory_order_acquire) >= Capacity) {
+      _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    _buf[tail & (Capacity - 1)] = item;
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pushBatch(const T* items, size_t n) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (n > Capacity - (tail - _head.load(std::memory_order_acquire))) {
+      _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+    for (size_t i = 0; i < n; ++i) _buf[(tail + i) & (Capacity - 1)] = items[i];
+    _tail.store(tail + static_cast<uint32_t>(n), std::memory_order_release);
+    return true;
+  }
+
+  // Nur vom Konsumenten; bis zu max Elemente, Rückgabe: Anzahl
+  size_t popBatch(T* out, size_t max) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    uint32_t available = _tail.load(std::memory_order_acquire) - head;
+    size_t n = available < max ? available : max;
+    for (size_t i = 0; i < n; ++i) out[i] = _buf[(head + i) & (Capacity - 1)];
+    _head.store(head + static_cast<uint32_t>(n), std::memory_order_release);
+    return n;
+  }
+
+  bool pop(T& out) { return popBatch(&out, 1) == 1; }
+
+  size_t size() const { return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire); }
+  static constexpr size_t capacity() { return Capacity; }
+  uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+  T _buf[Capacity];
+  std::atomic<uint32_t> _head; // Nächstes zu lesendes Element (Konsument)
+  std::atomic<uint32_t> _tail; // Nächste freie Zelle (Produzent)
+  std::atomic<uint32_t> _dropped;
+};
+
+template <typename T, size_t Capacity>
+class MpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity muss eine Zweierpotenz sein");
+
+public:
+  MpscQueue() : _tail(0), _dropped(0), _head(0) {
+    for (size_t i = 0; i < Capacity; ++i) _cells[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+  }
+
+  // Von beliebig vielen Produzenten (Tasks, ISRs, beide Kerne)
+  bool push(const T& item) {
+    uint32_t pos = _tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &_cells[pos & (Capacity - 1)];
+      int32_t diff = static_cast<int32_t>(cell->seq.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        _dropped.fetch_add(1, std::memory_order_relaxed); // Zelle noch nicht gelesen: voll
+        return false;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->item = item;
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Reserviert n aufeinanderfolgende Zellen per CAS. Der Konsument gibt Zellen
+  // in Reihenfolge frei, daher genügt die Prüfung der letzten.
+  bool pushBatch(const T* items, size_t n) {
+    if (n == 0) return true;
+    if (n > Capacity) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    uint32_t count = static_cast<uint32_t>(n);
+    uint32_t pos = _tail.load(std::memory_order_relaxed);
+    while (true) {
+      uint32_t last = pos + count - 1;
+      int32_t diff = static_cast<int32_t>(_cells[last & (Capacity - 1)].seq.load(std::memory_order_acquire) - last);
+      if (diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      Cell& cell = _cells[(pos + i) & (Capacity - 1)];
+      cell.item = items[i];
+      cell.seq.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+  }
+
+  // Nur vom Konsumenten; endet am ersten noch nicht freigegebenen Element
+  size_t popBatch(T* out, size_t max) {
+    size_t n = 0;
+    while (n < max) {
+      Cell& cell = _cells[_head & (Capacity - 1)];
+      if (cell.seq.load(std::memory_order_acquire) != _head + 1) break;
+      out[n++] = cell.item;
+      cell.seq.store(_head + Capacity, std::memory_order_release);
+      _head++;
+    }
+    return n;
+  }
+
+  bool pop(T& out) { return popBatch(&out, 1) == 1; }
+
+  // Nur vom Konsumenten; zählt auch reservierte, noch nicht freigegebene Zellen
+  size_t size() const { return _tail.load(std::memory_order_acquire) - _head; }
+  static constexpr size_t capacity() { return Capacity; }
+  uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+  struct Cell {
+    std::atomic<uint32_t> seq;
+    T item;
+  };
+
+  Cell _cells[Capacity];
+  std::atomic<uint32_t> _tail;
+  std::atomic<uint32_t> _dropped;
+  uint32_t _head; // Nur vom Konsumenten
+};
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef KALMAN_N_H
+#define KALMAN_N_H
+
+#include <stddef.h>
+#include <math.h>
+#include <array>
+
+// Mehrdimensionaler Kalman-Filter mit Dimensionen zur Compile-Zeit.
+//
+// Alle Matrizen liegen als std::array in fester Größe auf dem Stack bzw. im
+// Objekt (kein Heap). Die Kovarianz wird in Joseph-Form aktualisiert,
+//   P = (I - K H) P (I - K H)^T + K R K^T,
+// die auch mit float und gerundetem K symmetrisch und positiv semidefinit
+// bleibt; S = H P H^T + R wird per Cholesky gelöst statt invertiert.
+//
+// KalmanFilterN<N>            allgemeines Modell (F, Q, H, R vom Aufrufer)
+// ConstantVelocityKalman<A>   A Achsen mit Position und Geschwindigkeit,
+//                             Beschleunigung als Prozessrauschen oder IMU-Eingang
+
+#ifndef KALMAN_SYMMETRIZE
+#define KALMAN_SYMMETRIZE 1 // P nach jedem Schritt symmetrisieren (gegen Drift durch Rundung)
+#endif
+
+// Matrix R x C, zeilenweise
+template <size_t R, size_t C>
+struct KalmanMatrix {
+  std::array<float, R * C> m;
+
+  float& operator()(size_t r, size_t c) { return m[r * C + c]; }
+  const float& operator()(size_t r, size_t c) const { return m[r * C + c]; }
+
+  static KalmanMatrix zero() {
+    KalmanMatrix a;
+    a.m.fill(0.0f);
+    return a;
+  }
+  static KalmanMatrix identity() {
+    static_assert(R == C, "KalmanMatrix::identity: nur quadratisch");
+    KalmanMatrix a = zero();
+    for (size_t i = 0; i < R; ++i) a(i, i) = 1.0f;
+    return a;
+  }
+};
+
+template <size_t N>
+using KalmanVector = KalmanMatrix<N, 1>;
+
+// A * B
+template <size_t R, size_t K, size_t C>
+KalmanMatrix<R, C> kalmanMul(const KalmanMatrix<R, K>& a, const KalmanMatrix<K, C>& b) {
+  KalmanMatrix<R, C> out = KalmanMatrix<R, C>::zero();
+  for (size_t i = 0; i < R; ++i) {
+    for (size_t k = 0; k < K; ++k) {
+      float aik = a(i, k);
+      for (size_t j = 0; j < C; ++j) out(i, j) += aik * b(k, j);
+    }
+  }
+  return out;
+}
+
+// A * B^T
+template <size_t R, size_t K, size_t C>
+KalmanMatrix<R, C> kalmanMulTransposed(const KalmanMatrix<R, K>& a, const KalmanMatrix<C, K>& b) {
+  KalmanMatrix<R, C> out;
+  for (size_t i = 0; i < R; ++i) {
+    for (size_t j = 0; j < C; ++j) {
+      float sum = 0.0f;
+      for (size_t k = 0; k < K; ++k) sum += a(i, k) * b(j, k);
+      out(i, j) = sum;
+    }
+  }
+  return out;
+}
+
+template <size_t N>
+void kalmanSymmetrize(KalmanMatrix<N, N>& a) {
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t j = i + 1; j < N; ++j) {
+      float mean = 0.5f * (a(i, j) + a(j, i));
+      a(i, j) = mean;
+      a(j, i) = mean;
+    }
+  }
+}
+
+// Cholesky-Zerlegung S = L L^T in place (unteres Dreieck), false wenn S nicht positiv definit
+template <size_t M>
+bool kalmanCholesky(KalmanMatrix<M, M>& s) {
+  for (size_t j = 0; j < M; ++j) {
+    float d = s(j, j);
+    for (size_t k = 0; k < j; ++k) d -= s(j, k) * s(j, k);
+    if (!(d > 0.0f)) return false; // Auch NaN
+    d = sqrtf(d);
+    s(j, j) = d;
+    float inv = 1.0f / d;
+    for (size_t i = j + 1; i < M; ++i) {
+      float v = s(i, j);
+      for (size_t k = 0; k < j; ++k) v -= s(i, k) * s(j, k);
+      s(i, j) = v * inv;
+    }
+  }
+  return true;
+}
+
+// Löst L L^T x = b für einen Spaltenvektor b (in place)
+template <size_t M>
+void kalmanCholeskySolve(const KalmanMatrix<M, M>& l, float* b) {
+  for (size_t i = 0; i < M; ++i) {
+    float v = b[i];
+    for (size_t k = 0; k < i; ++k) v -= l(i, k) * b[k];
+    b[i] = v / l(i, i);
+  }
+  for (size_t i = M; i-- > 0;) {
+    float v = b[i];
+    for (size_t k = i + 1; k < M; ++k) v -= l(k, i) * b[k];
+    b[i] = v / l(i, i);
+  }
+}
+
+template <size_t N>
+class KalmanFilterN {
+  static_assert(N >= 1, "KalmanFilterN<N>: N >= 1");
+
+public:
+  typedef KalmanVector<N> State;
+  typedef KalmanMatrix<N, N> Covariance;
+
+  KalmanFilterN() : _x(State::zero()), _P(Covariance::identity()), _nis(0.0f) {}
+
+  void reset(const State& x, const Covariance& P) {
+    _x = x;
+    _P = P;
+    _nis = 0.0f;
+  }
+
+  // x = F x + u, P = F P F^T + Q (u: Steuereingang B * u, z. B. IMU)
+  void predict(const KalmanMatrix<N, N>& F, const Covariance& Q, const State& u = State::zero()) {
+    _x = kalmanMul(F, _x);
+    for (size_t i = 0; i < N; ++i) _x.m[i] += u.m[i];
+    _P = kalmanMulTransposed(kalmanMul(F, _P), F);
+    for (size_t i = 0; i < N * N; ++i) _P.m[i] += Q.m[i];
+#if KALMAN_SYMMETRIZE
+    kalmanSymmetrize(_P);
+#endif
+  }
+
+  // Messung z = H x + v, v ~ N(0, R). gate > 0: verwirft die Messung, wenn die
+  // normierte Innovation y^T S^-1 y größer als gate^2 ist (Ausreißer).
+  // false bei verworfener Messung oder nicht positiv definitem S; der Zustand
+  // bleibt dann unverändert.
+  template <size_t M>
+  bool update(const KalmanVector<M>& z, const KalmanMatrix<M, N>& H, const KalmanMatrix<M, M>& R, float gate = 0.0f) {
+    KalmanMatrix<N, M> PHt = kalmanMulTransposed(_P, H);
+    KalmanMatrix<M, M> S = kalmanMul(H, PHt);
+    for (size_t i = 0; i < M * M; ++i) S.m[i] += R.m[i];
+    if (!kalmanCholesky(S)) return false;
+
+    KalmanVector<M> y = kalmanMul(H, _x);
+    for (size_t i = 0; i < M; ++i) y.m[i] = z.m[i] - y.m[i];
+    KalmanVector<M> w = y;
+    kalmanCholeskySolve(S, w.m.data());
+    float nis = 0.0f;
+    for (size_t i = 0; i < M; ++i) nis += y.m[i] * w.m[i];
+    _nis = nis;
+    if (gate > 0.0f && !(nis <= gate * gate)) return false;
+
+    // K = P H^T S^-1, zeilenweise: S k_i = (P H^T)_i
+    KalmanMatrix<N, M> K;
+    for (size_t i = 0; i < N; ++i) {
+      float* row = K.m.data() + i * M;
+      for (size_t j = 0; j < M; ++j) row[j] = PHt(i, j);
+      kalmanCholeskySolve(S, row);
+    }
+    for (size_t i = 0; i < N; ++i) {
+      float dx = 0.0f;
+      for (size_t j = 0; j < M; ++j) dx += PHt(i, j) * w.m[j];
+      _x.m[i] += dx;
+    }
+
+    // Joseph-Form
+    KalmanMatrix<N, N> A = kalmanMul(K, H);
+    for (size_t i = 0; i < N * N; ++i) A.m[i] = -A.m[i];
+    for (size_t i = 0; i < N; ++i) A(i, i) += 1.0f;
+    _P = kalmanMulTransposed(kalmanMul(A, _P), A);
+    KalmanMatrix<N, N> KRKt = kalmanMulTransposed(kalmanMul(K, R), K);
+    for (size_t i = 0; i < N * N; ++i) _P.m[i] += KRKt.m[i];
+#if KALMAN_SYMMETRIZE
+    kalmanSymmetrize(_P);
+#endif
+    return true;
+  }
+
+  const State& state() const { return _x; }
+  const Covariance& covariance() const { return _P; }
+  float nis() const { return _nis; } // Normierte Innovation der letzten Messung
+
+private:
+  State _x;
+  Covariance _P;
+  float _nis;
+};
+
+// Konstante Geschwindigkeit in Axes Achsen. Zustand [p_0 .. p_A-1, v_0 .. v_A-1],
+// Beschleunigung stückweise konstant mit Standardabweichung accelSigma (m/s^2):
+//   Q = accelSigma^2 * G G^T, G = [dt^2/2; dt] je Achse.
+// Mit IMU wird die gemessene Beschleunigung als Steuereingang B a = G a
+// verwendet; accelSigma ist dann das Rauschen der IMU statt der Manöver.
+template <size_t Axes>
+class ConstantVelocityKalman {
+  static_assert(Axes >= 1, "ConstantVelocityKalman<Axes>: Axes >= 1");
+
+public:
+  static constexpr size_t kStates = 2 * Axes;
+  typedef KalmanFilterN<kStates> Filter;
+
+  explicit ConstantVelocityKalman(float accelSigma = 1.0f) : _accelSigma(accelSigma) {}
+
+  bool valid() const { return _accelSigma > 0; }
+  void setAccelSigma(float accelSigma) { _accelSigma = accelSigma; }
+
+  // Start aus Position und Geschwindigkeit (velocity == nullptr: 0) mit Unsicherheiten je Achse
+  void reset(const float* position, const float* velocity, const float* positionSigma, const float* velocitySigma) {
+    typename Filter::State x = Filter::State::zero();
+    typename Filter::Covariance P = Filter::Covariance::zero();
+    for (size_t a = 0; a < Axes; ++a) {
+      x.m[a] = position[a];
+      x.m[Axes + a] = velocity ? velocity[a] : 0.0f;
+      P(a, a) = positionSigma[a] * positionSigma[a];
+      P(Axes + a, Axes + a) = velocitySigma[a] * velocitySigma[a];
+    }
+    _filter.reset(x, P);
+  }
+
+  // Positionen um delta verschieben (neuer Ursprung), Kovarianz unverändert
+  void shiftPosition(const float* delta) {
+    typename Filter::State x = _filter.state();
+    for (size_t a = 0; a < Axes; ++a) x.m[a] -= delta[a];
+    _filter.reset(x, _filter.covariance());
+  }
+
+  // Vorhersage um dt Sekunden, accel (m/s^2, je Achse) optional aus einer IMU
+  void predict(float dt, const float* accel = nullptr) {
+    if (!(dt > 0.0f)) return;
+    float g0 = 0.5f * dt * dt;
+    float var = _accelSigma * _accelSigma;
+    KalmanMatrix<kStates, kStates> F = KalmanMatrix<kStates, kStates>::identity();
+    typename Filter::Covariance Q = Filter::Covariance::zero();
+    typename Filter::State u = Filter::State::zero();
+    for (size_t a = 0; a < Axes; ++a) {
+      size_t p = a, v = Axes + a;
+      F(p, v) = dt;
+      Q(p, p) = var * g0 * g0;
+      Q(p, v) = var * g0 * dt;
+      Q(v, p) = Q(p, v);
+      Q(v, v) = var * dt * dt;
+      if (accel) {
+        u.m[p] = g0 * accel[a];
+        u.m[v] = dt * accel[a];
+      }
+    }
+    _filter.predict(F, Q, u);
+  }
+
+  // Messung der Positionen aller Achsen, sigma je Achse
+  bool updatePosition(const float* position, const float* sigma, float gate = 0.0f) {
+    KalmanVector<Axes> z;
+    KalmanMatrix<Axes, kStates> H = KalmanMatrix<Axes, kStates>::zero();
+    KalmanMatrix<Axes, Axes> R = KalmanMatrix<Axes, Axes>::zero();
+    for (size_t a = 0; a < Axes; ++a) {
+      z.m[a] = position[a];
+      H(a, a) = 1.0f;
+      R(a, a) = sigma[a] * sigma[a];
+    }
+    return _filter.update(z, H, R, gate);
+  }
+
+  // Beliebige lineare Messung (z. B. nur einzelne Geschwindigkeiten)
+  template <size_t M>
+  bool update(const KalmanVector<M>& z, const KalmanMatrix<M, kStates>& H, const KalmanMatrix<M, M>& R, float gate = 0.0f) {
+    return _filter.update(z, H, R, gate);
+  }
+
+  float position(size_t axis) const { return _filter.state().m[axis]; }
+  float velocity(size_t axis) const { return _filter.state().m[Axes + axis]; }
+  float positionVariance(size_t axis) const { return _filter.covariance()(axis, axis); }
+  float velocityVariance(size_t axis) const { return _filter.covariance()(Axes + axis, Axes + axis); }
+  const Filter& filter() const { return _filter; }
+
+private:
+  float _accelSigma;
+  Filter _filter;
+};
+
+#endif
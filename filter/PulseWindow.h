@@ -0,0 +1,165 @@
+#ifndef PULSE_WINDOW_H
+#define PULSE_WINDOW_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "FilterMath.h"
+
+#define CPM_BUCKET_MS 1000          // Zeitauflösung der Pulsbuckets
+#define CPM_WINDOW_BUCKETS 300      // Ringlänge: längstes Fenster 5 min
+#define CPM_DEFAULT_WINDOW_MS 60000 // Fenster von getCPM(), 0 = adaptiv
+#define CPM_ADAPTIVE_MIN_MS 10000   // Adaptiv: kürzestes Fenster
+#define CPM_ADAPTIVE_COUNTS 400     // Adaptiv: Zielzählung (ca. 5 % statistische Unsicherheit)
+#define CPM_MIN_LIVE_FRACTION 0.1f  // Totzeitkorrektur: 1 - m * tau nicht kleiner als dieser Wert
+
+// Gezählte Pulse in einem Zeitfenster
+struct PulseSpan {
+  uint32_t counts;
+  unsigned long spanMs;
+};
+
+// Ring von Pulsbuckets fester Zeitdauer für fensterbasierte Zählraten (COUNT_MODE).
+//
+// Der Ring speichert je Bucket den kumulierten Zählerstand an seinem Ende.
+// Die Zählung eines Fensters aus W Buckets ist damit eine Differenz
+// (aktueller Stand minus Stand vor W Buckets), O(1) für jede Fensterlänge
+// bis capacity Buckets. Das Fenster endet jetzt und enthält den laufenden,
+// angebrochenen Bucket; spanMs ist die tatsächlich abgedeckte Zeit.
+// add() schließt übersprungene Buckets ab (höchstens capacity Schritte) und
+// nimmt einzelne Pulse ebenso wie gesammelte Zählerstände an.
+// Gerechnet wird ab dem Beginn des laufenden Buckets, nicht ab reset():
+// Die Zeitdifferenzen bleiben klein, auch nach dem Überlauf von millis().
+class PulseWindow {
+public:
+  PulseWindow() : _bucketMs(CPM_BUCKET_MS), _bucketStart(0), _pos(0), _closed(0), _total(0) {}
+
+  // capacity == 0 schaltet den Ring ab (VALUE_MODE)
+  void reset(size_t capacity, unsigned long now, unsigned long bucketMs = CPM_BUCKET_MS) {
+    _cum.assign(capacity, 0);
+    _bucketMs = bucketMs > 0 ? bucketMs : 1;
+    _bucketStart = now;
+    _pos = 0;
+    _closed = 0;
+    _total = 0;
+  }
+
+  bool enabled() const { return !_cum.empty(); }
+  size_t capacity() const { return _cum.size(); }
+  unsigned long bucketMs() const { return _bucketMs; }
+  uint32_t total() const { return _total; }
+
+  void add(uint32_t counts, unsigned long now) {
+    if (_cum.empty()) return;
+    advance(now);
+    _total += counts;
+  }
+
+  // Pulse der letzten windowMs (auf ganze Buckets gerundet, höchstens capacity Buckets)
+  PulseSpan window(unsigned long windowMs, unsigned long now) {
+    PulseSpan span = {0, 0};
+    if (_cum.empty()) return span;
+    advance(now);
+    unsigned long buckets = (windowMs + _bucketMs - 1) / _bucketMs;
+    if (buckets < 1) buckets = 1;
+    if (buckets > _cum.size()) buckets = _cum.size();
+    unsigned long inBucket = timeSince(now, _bucketStart); // 0 bei Zeitstempeln vor dem laufenden Bucket
+    if (buckets > _closed) {
+      span.counts = _total; // Fenster reicht bis reset() zurück
+      span.spanMs = _closed * _bucketMs + inBucket;
+    } else {
+      span.counts = _total - _cum[(_pos + _cum.size() - buckets) % _cum.size()];
+      span.spanMs = (buckets - 1) * _bucketMs + inBucket;
+    }
+    if (span.spanMs == 0) span.spanMs = 1;
+    return span;
+  }
+
+  // Kürzestes Fenster ab CPM_ADAPTIVE_MIN_MS (verdoppelt bis zum ganzen Ring),
+  // das mindestens CPM_ADAPTIVE_COUNTS Pulse enthält: hohe Raten reagieren
+  // schnell, niedrige werden über längere Zeit gemittelt.
+  PulseSpan adaptive(unsigned long now) {
+    unsigned long longest = _cum.size() * _bucketMs;
+    unsigned long windowMs = CPM_ADAPTIVE_MIN_MS < longest ? CPM_ADAPTIVE_MIN_MS : longest;
+    PulseSpan span = window(windowMs, now);
+    while (span.counts < CPM_ADAPTIVE_COUNTS && windowMs < longest) {
+      windowMs = 2 * windowMs < longest ? 2 * windowMs : longest;
+      span = window(windowMs, now);
+    }
+    return span;
+  }
+
+  // Snapshot (filter/Snapshot.h): nur die abgeschlossenen Buckets, älteste zuerst
+  template <typename Archive>
+  void save(Archive& out) const {
+    out.u32(_cum.size());
+    out.u32(_bucketMs);
+    out.time(_bucketStart);
+    out.u32(_pos);
+    out.u32(_closed);
+    out.io(_total);
+    for (size_t i = 0; i < _closed; ++i) out.io(_cum[slot(i)]);
+  }
+
+  template <typename Archive>
+  void restore(Archive& in) {
+    size_t capacity = 0;
+    unsigned long bucketMs = 0;
+    in.u32(capacity);
+    in.u32(bucketMs);
+    if (capacity != 0 && capacity != CPM_WINDOW_BUCKETS) {
+      in.fail();
+      return;
+    }
+    reset(capacity, 0, bucketMs);
+    size_t pos = 0;
+    size_t closed = 0;
+    in.time(_bucketStart);
+    in.u32(pos);
+    in.u32(closed);
+    in.io(_total);
+    if (closed > capacity || (pos >= capacity && capacity > 0) || closed * sizeof(uint32_t) > in.remaining()) {
+      in.fail();
+      return;
+    }
+    _pos = pos;
+    _closed = closed;
+    for (size_t i = 0; i < _closed; ++i) in.io(_cum[slot(i)]);
+  }
+
+private:
+  std::vector<uint32_t> _cum; // Kumulierter Zählerstand am Ende jedes abgeschlossenen Buckets
+  unsigned long _bucketMs;
+  unsigned long _bucketStart; // Beginn des laufenden Buckets
+  size_t _pos;                // Ringindex des laufenden Buckets
+  size_t _closed;             // Abgeschlossene Buckets im Ring, höchstens capacity
+  uint32_t _total;            // Zählerstand einschließlich laufendem Bucket
+
+  // Ringindex des i-ten abgeschlossenen Buckets, 0 = ältester
+  size_t slot(size_t i) const { return (_pos + _cum.size() - _closed + i) % _cum.size(); }
+
+  void advance(unsigned long now) {
+    unsigned long elapsed = timeSince(now, _bucketStart);
+    if (elapsed < _bucketMs) return;
+    unsigned long steps = elapsed / _bucketMs;
+    size_t capacity = _cum.size();
+    if (steps >= capacity) {
+      for (size_t i = 0; i < capacity; ++i) _cum[i] = _total;
+    } else {
+      for (size_t i = 0; i < steps; ++i) _cum[(_pos + i) % capacity] = _total;
+    }
+    _bucketStart += steps * _bucketMs;
+    _pos = (_pos + steps % capacity) % capacity;
+    _closed = steps >= capacity - _closed ? capacity : _closed + steps;
+  }
+};
+
+// Nicht paralysierbare Totzeitkorrektur n = m / (1 - m * tau), m und n in Pulsen/s.
+// Nahe der Sättigung (m * tau -> 1) begrenzt auf m / CPM_MIN_LIVE_FRACTION.
+inline float deadTimeCorrectedRate(float measuredPerSecond, float deadTimeSeconds) {
+  float live = 1.0f - measuredPerSecond * deadTimeSeconds;
+  if (live < CPM_MIN_LIVE_FRACTION) live = CPM_MIN_LIVE_FRACTION;
+  return measuredPerSecond / live;
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SENSOR_REGISTRY_H
+#define SENSOR_REGISTRY_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <vector>
+
+typedef int SensorHandle;
+#define INVALID_SENSOR_HANDLE -1
+
+// Zuordnung Sensor -> zusammenhängender Kanalbereich.
+//
+// Die Sensor-ID wird nur beim Registrieren (setup) verglichen; der Handle ist
+// der Index in _routes, ein Push über den Handle kostet einen Array-Zugriff
+// ohne String-Vergleich. Bereiche verschiedener Sensoren überlappen nicht.
+class SensorRegistry {
+public:
+  struct Route {
+    String id;
+    size_t firstChannel;
+    size_t channelCount;
+  };
+
+  // Neuer Handle, bestehender Handle bei gleicher ID und gleichem Bereich,
+  // INVALID_SENSOR_HANDLE bei leerem/zu großem Bereich, Überlappung oder
+  // gleicher ID mit anderem Bereich.
+  SensorHandle add(const String& id, size_t firstChannel, size_t channelCount, size_t totalChannels) {
+    if (channelCount == 0 || firstChannel >= totalChannels || channelCount > totalChannels - firstChannel) {
+      return INVALID_SENSOR_HANDLE;
+    }
+    for (size_t i = 0; i < _routes.size(); ++i) {
+      const Route& route = _routes[i];
+      if (route.id == id) {
+        bool same = route.firstChannel == firstChannel && route.channelCount == channelCount;
+        return same ? static_cast<SensorHandle>(i) : INVALID_SENSOR_HANDLE;
+      }
+      if (firstChannel < route.firstChannel + route.channelCount && route.firstChannel < firstChannel + channelCount) {
+        return INVALID_SENSOR_HANDLE;
+      }
+    }
+    Route route = {id, firstChannel, channelCount};
+    _routes.push_back(route);
+    return static_cast<SensorHandle>(_routes.size() - 1);
+  }
+
+  SensorHandle find(const String& id) const {
+    for (size_t i = 0; i < _routes.size(); ++i) {
+      if (_routes[i].id == id) return static_cast<SensorHandle>(i);
+    }
+    return INVALID_SENSOR_HANDLE;
+  }
+
+  // nullptr bei ungültigem Handle
+  const Route* route(SensorHandle handle) const {
+    if (handle < 0 || static_cast<size_t>(handle) >= _routes.size()) return nullptr;
+    return &_routes[handle];
+  }
+
+  size_t size() const { return _routes.size(); }
+
+private:
+  std::vector<Route> _routes;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// Binärabbild des Filterzustands (Deep Sleep, Warmstart), siehe
+// DynamicAdaptiveFilterV2::saveSnapshot().
+//
+// Aufbau: SnapshotHeader, danach die Kanäle in Reihenfolge. Werte liegen in
+// der Byte-Reihenfolge der Plattform; das Abbild ist nur für denselben Build
+// (Plattform, USE_*, DAF_FIXED_POINT) gedacht, was build im Header prüft.
+// Zeitpunkte werden als Alter relativ zum Speicherzeitpunkt abgelegt und beim
+// Einlesen auf das aktuelle millis() umgerechnet, damit ein Neustart von
+// millis() nach dem Aufwachen keine Rolle spielt.
+
+#define SNAPSHOT_MAGIC 0x53464144UL // "DAFS"
+#define SNAPSHOT_VERSION 5
+
+#define SNAPSHOT_BUILD_KALMAN 0x01
+#define SNAPSHOT_BUILD_LMS 0x02
+#define SNAPSHOT_BUILD_RLS 0x04
+#define SNAPSHOT_BUILD_FIXED 0x08
+
+struct SnapshotHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t build;        // SNAPSHOT_BUILD_*
+  uint32_t channels;
+  uint32_t configHash;   // snapshotHash() über alle FilterConfig
+  uint32_t payloadSize;  // Bytes nach dem Header
+  uint32_t crc;          // snapshotCrc32() über die Nutzdaten
+};
+
+// CRC-32 (IEEE 802.3, reflektiert), Nibble-Tabelle: 64 Byte Flash, 2 Nachschläge pro Byte
+inline uint32_t snapshotCrc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+  static const uint32_t table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+  };
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+    crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+  }
+  return ~crc;
+}
+
+// FNV-1a, fortsetzbar über mehrere Felder
+inline uint32_t snapshotHash(const void* data, size_t size, uint32_t hash = 2166136261UL) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+// Schreibt in einen Puffer fester Größe; dst == nullptr zählt nur (snapshotSize()).
+// Gegenstück SnapshotReader hat dieselben Methoden, so dass ein Zustand mit
+// einer einzigen Template-Funktion geschrieben und gelesen wird.
+class SnapshotWriter {
+public:
+  SnapshotWriter(uint8_t* dst, size_t capacity, unsigned long now)
+      : _dst(dst), _capacity(capacity), _size(0), _now(now), _ok(true) {}
+
+  template <typename T>
+  void io(const T& value) { bytes(&value, sizeof(T)); }
+
+  template <typename T>
+  void array(const T* values, size_t n) { bytes(values, n * sizeof(T)); }
+
+  // Breitenunabhängig als uint32_t (unsigned long ist auf dem Host 64 Bit)
+  template <typename T>
+  void u32(const T& value) { io(static_cast<uint32_t>(value)); }
+
+  // Zeitpunkt als Alter relativ zu now
+  void time(unsigned long t) { u32(_now - t); }
+
+  template <typename T>
+  void vector(const std::vector<T>& values) {
+    u32(values.size());
+    array(values.data(), values.size());
+  }
+
+  // Bestandteile mit save()/restore() (HistoryRing, StreamingMAD, PulseWindow)
+  template <typename T>
+  void object(const T& part) { part.save(*this); }
+
+  bool ok() const { return _ok; }
+  size_t size() const { return _size; }
+
+private:
+  uint8_t* _dst;
+  size_t _capacity;
+  size_t _size;
+  unsigned long _now;
+  bool _ok;
+
+  void bytes(const void* src, size_t n) {
+    if (_dst != nullptr) {
+      if (n > _capacity - _size) {
+        _ok = false;
+        _size = _capacity;
+        return;
+      }
+      memcpy(_dst + _size, src, n);
+    }
+    _size += n;
+  }
+};
+
+class SnapshotReader {
+public:
+  // elapsedMs: zwischen Speichern und Einlesen vergangene Zeit
+  SnapshotReader(const uint8_t* src, size_t size, unsigned long now, unsigned long elapsedMs)
+      : _src(src), _size(size), _pos(0), _now(now - elapsedMs), _ok(true) {}
+
+  template <typename T>
+  void io(T& value) { bytes(&value, sizeof(T)); }
+
+  template <typename T>
+  void array(T* values, size_t n) { bytes(values, n * sizeof(T)); }
+
+  template <typename T>
+  void u32(T& value) {
+    uint32_t v = 0;
+    io(v);
+    value = static_cast<T>(v);
+  }
+
+  // Modulo-Arithmetik: liegt der Zeitpunkt vor dem Start von millis(), läuft er
+  // über und wird von timeSince() trotzdem richtig verrechnet
+  void time(unsigned long& t) {
+    uint32_t age = 0;
+    io(age);
+    t = _now - age;
+  }
+
+  template <typename T>
+  void vector(std::vector<T>& values) {
+    size_t n = 0;
+    u32(n);
+    if (n * sizeof(T) > remaining()) {
+      fail();
+      return;
+    }
+    values.resize(n);
+    array(values.data(), n);
+  }
+
+  template <typename T>
+  void object(T& part) { part.restore(*this); }
+
+  // Für Bestandteile, deren gespeicherte Größe nicht passt
+  void fail() { _ok = false; }
+  bool ok() const { return _ok; }
+  size_t remaining() const { return _size - _pos; }
+
+private:
+  const uint8_t* _src;
+  size_t _size;
+  size_t _pos;
+  unsigned long _now;
+  bool _ok;
+
+  void bytes(void* dst, size_t n) {
+    if (!_ok || n > _size - _pos) {
+      _ok = false;
+      memset(dst, 0, n);
+      return;
+    }
+    memcpy(dst, _src + _pos, n);
+    _pos += n;
+  }
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef STREAMING_MAD_H
+#define STREAMING_MAD_H
+
+#include <stddef.h>
+#include <vector>
+
+// Gleitender Median / MAD (Median Absolute Deviation) über ein festes Fenster.
+//
+// Das Fenster wird zweimal gehalten: in Ankunftsreihenfolge (Ring) und
+// sortiert. Ein neues Sample ersetzt das älteste im sortierten Array per
+// Binärsuche und einer einzigen Verschiebung zwischen alter und neuer
+// Position. Median ist danach O(1), die MAD O(log N): Die Abweichungen links
+// und rechts des Medians bilden zwei bereits sortierte Folgen, aus denen das
+// k-kleinste Element per Binärsuche bestimmt wird. Kein Sortieren und kein
+// Heap-Zugriff nach reset().
+//
+// push() ist wegen der Verschiebung O(N) im schlechtesten Fall (neuer Wert
+// am anderen Ende als der älteste). Bei MAD_WINDOW_LENGTH 9 sind das höchstens
+// 8 Kopien auf 36 Byte, billiger als jede O(log N)-Struktur
+// (Heaps, Skip-Liste) mit ihrem Verwaltungsaufwand. Für Fenster im
+// Hunderterbereich wäre ein Zwei-Heap-Median die bessere Wahl.
+class StreamingMAD {
+public:
+  StreamingMAD() : _window(0), _count(0), _next(0) {}
+
+  void reset(size_t window) {
+    _window = window;
+    _ring.assign(window, 0.0f);
+    _sorted.assign(window, 0.0f);
+    _count = 0;
+    _next = 0;
+  }
+
+  void clear() {
+    _count = 0;
+    _next = 0;
+  }
+
+  bool enabled() const { return _window > 0; }
+  size_t size() const { return _count; }
+  size_t window() const { return _window; }
+
+  void push(float value) {
+    if (_window == 0) return;
+    size_t pos;
+    if (_count < _window) {
+      pos = _count++;
+    } else {
+      pos = lowerBound(_ring[_next]);
+    }
+    _ring[_next] = value;
+    _next = _next + 1 == _window ? 0 : _next + 1;
+
+    // Freie Stelle pos zur Einfügeposition von value schieben
+    while (pos > 0 && _sorted[pos - 1] > value) {
+      _sorted[pos] = _sorted[pos - 1];
+      --pos;
+    }
+    while (pos + 1 < _count && _sorted[pos + 1] < value) {
+      _sorted[pos] = _sorted[pos + 1];
+      ++pos;
+    }
+    _sorted[pos] = value;
+  }
+
+  float median() const {
+    if (_count == 0) return 0.0f;
+    size_t h = _count / 2;
+    return (_count % 2 == 0) ? (_sorted[h - 1] + _sorted[h]) / 2.0f : _sorted[h];
+  }
+
+  // MAD, skaliert auf die Standardabweichung einer Normalverteilung (x 1.4826)
+  float mad() const {
+    if (_count == 0) return 0.0f;
+    float m = median();
+    size_t h = _count / 2;
+    float raw = (_count % 2 == 0) ?
+      (kthDeviation(m, h - 1) + kthDeviation(m, h)) / 2.0f :
+      kthDeviation(m, h);
+    return raw * 1.4826f;
+  }
+
+  // Snapshot (filter/Snapshot.h): Fenster in Ankunfts- und sortierter Reihenfolge
+  template <typename Archive>
+  void save(Archive& out) const {
+    out.u32(_window);
+    out.u32(_count);
+    out.u32(_next);
+    out.array(_ring.data(), _count);
+    out.array(_sorted.data(), _count);
+  }
+
+  template <typename Archive>
+  void restore(Archive& in) {
+    size_t window = 0;
+    size_t count = 0;
+    size_t next = 0;
+    in.u32(window);
+    in.u32(count);
+    in.u32(next);
+    if (count > window || (next >= window && window > 0) || 2 * count * sizeof(float) > in.remaining()) {
+      in.fail();
+      return;
+    }
+    if (window != _window) reset(window);
+    in.array(_ring.data(), count);
+    in.array(_sorted.data(), count);
+    _count = count;
+    _next = next;
+  }
+
+private:
+  std::vector<float> _ring;
+  std::vector<float> _sorted;
+  size_t _window;
+  size_t _count;
+  size_t _next;
+
+  size_t lowerBound(float value) const {
+    size_t lo = 0, hi = _count;
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (_sorted[mid] < value) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+  }
+
+  // Abweichungen links vom Median (aufsteigend): m - sorted[split - 1 - i]
+  // Abweichungen rechts vom Median (aufsteigend): sorted[split + j] - m
+  float kthDeviation(float m, size_t k) const {
+    size_t split = _count / 2;
+    const float* s = _sorted.data();
+    size_t na = split;
+    size_t nb = _count - split;
+    size_t take = k + 1;
+    size_t lo = take > nb ? take - nb : 0;
+    size_t hi = take < na ? take : na;
+    while (lo <= hi) {
+      size_t i = (lo + hi) / 2;
+      size_t j = take - i;
+      if (i > 0 && j < nb && (m - s[split - i]) > (s[split + j] - m)) {
+        hi = i - 1;
+      } else if (j > 0 && i < na && (s[split + j - 1] - m) > (m - s[split - 1 - i])) {
+        lo = i + 1;
+      } else {
+        float a = i > 0 ? m - s[split - i] : -1.0f;
+        float b = j > 0 ? s[split + j - 1] - m : -1.0f;
+        return a > b ? a : b;
+      }
+    }
+    return 0.0f;
+  }
+};
+
+#endif
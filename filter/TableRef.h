@@ -0,0 +1,40 @@
+#ifndef TABLE_REF_H
+#define TABLE_REF_H
+
+#include <stddef.h>
+#include <vector>
+
+// Nur lesender Verweis auf eine Tabelle: entweder fremd (constexpr-Tabelle im
+// Flash, statisches Array; muss den Verweis überleben) oder eigene Kopie aus
+// einem std::vector. Beim Kopieren zeigt die Kopie auf ihre eigene Kopie bzw.
+// weiter auf dieselbe fremde Tabelle.
+template <typename T>
+class TableRef {
+public:
+  TableRef(const T* data, size_t size) : _data(data), _size(size) {}
+  explicit TableRef(const std::vector<T>& values) : _owned(values), _data(_owned.data()), _size(_owned.size()) {}
+  TableRef(const TableRef& other) : _owned(other._owned), _data(other.rebind(_owned)), _size(other._size) {}
+  TableRef& operator=(const TableRef& other) {
+    if (this != &other) {
+      _owned = other._owned;
+      _data = other.rebind(_owned);
+      _size = other._size;
+    }
+    return *this;
+  }
+
+  const T& operator[](size_t i) const { return _data[i]; }
+  size_t size() const { return _size; }
+  const T* begin() const { return _data; }
+  const T* end() const { return _data + _size; }
+  bool owned() const { return !_owned.empty() && _data == _owned.data(); }
+
+private:
+  std::vector<T> _owned; // Leer bei fremder Tabelle
+  const T* _data;
+  size_t _size;
+
+  const T* rebind(const std::vector<T>& copy) const { return owned() ? copy.data() : _data; }
+};
+
+#endif
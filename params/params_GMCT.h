@@ -13,7 +13,7 @@ struct GMCT_Params {
 };
 
 // Definitionen für gängige GM-Zählrohre
-const GMCT_Params GMCT_SBM20 = {
+constexpr GMCT_Params GMCT_SBM20 = {
   100.0f,         // Dead Time: 100 µs
   1.0f / 220.0f,  // 220 CPM = 1 µSv/h
   5.0f,           // Threshold: 5%
@@ -21,7 +21,7 @@ const GMCT_Params GMCT_SBM20 = {
   10              // EMA-Länge: ~10 Minuten
 };
 
-const GMCT_Params GMCT_J305 = {
+constexpr GMCT_Params GMCT_J305 = {
   80.0f,          // Dead Time: 80 µs
   1.0f / 200.0f,  // 200 CPM = 1 µSv/h
   5.0f,           // Threshold: 5%
@@ -29,7 +29,7 @@ const GMCT_Params GMCT_J305 = {
   10              // EMA-Länge: 10
 };
 
-const GMCT_Params GMCT_STS5 = {
+constexpr GMCT_Params GMCT_STS5 = {
   120.0f,         // Dead Time: 120 µs
   1.0f / 240.0f,  // 240 CPM = 1 µSv/h
   5.0f,           // Threshold: 5%
@@ -37,7 +37,7 @@ const GMCT_Params GMCT_STS5 = {
   10              // EMA-Länge: 10
 };
 
-const GMCT_Params GMCT_LND712 = {
+constexpr GMCT_Params GMCT_LND712 = {
   60.0f,          // Dead Time: 60 µs
   1.0f / 175.0f,  // 175 CPM = 1 µSv/h
   3.0f,           // Threshold: 3%
@@ -45,26 +45,39 @@ const GMCT_Params GMCT_LND712 = {
   8               // EMA-Länge: 8
 };
 
-// Filterkonfigurationen für GM-Zählrohre
-const std::vector<FilterConfig> filter_sbm20 = {
+// COUNT_MODE-Kanal für ein Zählrohr: Pulse per onPulse()/onPulses(), getCPM() mit
+// fensterbasierter Rate und Totzeitkorrektur über tube.deadTimeUs
+constexpr FilterConfig gmctCountConfig(const GMCT_Params& tube) {
+  return {EMA, tube.recommendedLength, nullptr, 0, tube.recommendedNormalFreqHz, 86400000, 60000,
+          tube.recommendedThresholdPercent, tube.deadTimeUs, COUNT_MODE};
+}
+
+// Filterkonfigurationen für GM-Zählrohre: VALUE_MODE-Glättung bereits
+// berechneter CPM- bzw. µSv/h-Werte (pushSamples()). Ohne Totzeitkorrektur,
+// die gibt es nur für gezählte Pulse über gmctCountConfig().
+constexpr std::array<FilterConfig, 2> filter_sbm20 = {{
   {EMA, GMCT_SBM20.recommendedLength, nullptr, 0, GMCT_SBM20.recommendedNormalFreqHz, 10000, 1000, GMCT_SBM20.recommendedThresholdPercent, 0.0f, VALUE_MODE}, // CPM
   {EMA, GMCT_SBM20.recommendedLength, nullptr, 0, GMCT_SBM20.recommendedNormalFreqHz, 10000, 1000, GMCT_SBM20.recommendedThresholdPercent, 0.0f, VALUE_MODE}  // µSv/h
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_sbm20);
 
-const std::vector<FilterConfig> filter_j305 = {
+constexpr std::array<FilterConfig, 2> filter_j305 = {{
   {EMA, GMCT_J305.recommendedLength, nullptr, 0, GMCT_J305.recommendedNormalFreqHz, 10000, 1000, GMCT_J305.recommendedThresholdPercent, 0.0f, VALUE_MODE}, // CPM
   {EMA, GMCT_J305.recommendedLength, nullptr, 0, GMCT_J305.recommendedNormalFreqHz, 10000, 1000, GMCT_J305.recommendedThresholdPercent, 0.0f, VALUE_MODE}  // µSv/h
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_j305);
 
-const std::vector<FilterConfig> filter_sts5 = {
+constexpr std::array<FilterConfig, 2> filter_sts5 = {{
   {EMA, GMCT_STS5.recommendedLength, nullptr, 0, GMCT_STS5.recommendedNormalFreqHz, 10000, 1000, GMCT_STS5.recommendedThresholdPercent, 0.0f, VALUE_MODE}, // CPM
   {EMA, GMCT_STS5.recommendedLength, nullptr, 0, GMCT_STS5.recommendedNormalFreqHz, 10000, 1000, GMCT_STS5.recommendedThresholdPercent, 0.0f, VALUE_MODE}  // µSv/h
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_sts5);
 
-const std::vector<FilterConfig> filter_lnd712 = {
+constexpr std::array<FilterConfig, 2> filter_lnd712 = {{
   {EMA, GMCT_LND712.recommendedLength, nullptr, 0, GMCT_LND712.recommendedNormalFreqHz, 10000, 1000, GMCT_LND712.recommendedThresholdPercent, 0.0f, VALUE_MODE}, // CPM
   {EMA, GMCT_LND712.recommendedLength, nullptr, 0, GMCT_LND712.recommendedNormalFreqHz, 10000, 1000, GMCT_LND712.recommendedThresholdPercent, 0.0f, VALUE_MODE}  // µSv/h
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_lnd712);
 
 
 #endif
@@ -1,50 +1,78 @@
 #ifndef PARAMS_ANALOG_H
 #define PARAMS_ANALOG_H
 
-#include <vector>
+#include <array>
 #include "DynamicAdaptiveFilterV2.h"
+#include "filter/FIR_coefficients.h"
+#include "filter/FirDesign.h"
+#include "filter/BiquadDesign.h"
 
-// _TRAILER-Makro für FilterConfig-Initialisierung
+// _TRAILER-Makro für FilterConfig-Initialisierung. _TRAILER_NO_MAD ohne Hampel-Vorstufe
+// für DECIMATE: dort ersetzt sie Ausreißer durch den Median, bei quantisiertem
+// Eingang mit Rauschen unter 1 LSB ginge so der Gewinn der Überabtastung verloren.
 #if defined(USE_LMS)
   #define _TRAILER ,3.0f,0.01f  // madThreshold=3.0, mu=0.01
+  #define _TRAILER_NO_MAD ,0.0f,0.01f
 #elif defined(USE_RLS)
   #define _TRAILER ,3.0f,0.9f  // madThreshold=3.0, lambda=0.9
+  #define _TRAILER_NO_MAD ,0.0f,0.9f
 #elif defined(USE_KALMAN)
   #define _TRAILER ,3.0f,0.01f,0.01f,0.01f  // madThreshold=3.0, Q=0.01, R=0.01, initialState=0.01
+  #define _TRAILER_NO_MAD ,0.0f,0.01f,0.01f,0.01f
 #else
   #define _TRAILER ,3.0f  // Nur madThreshold=3.0
+  #define _TRAILER_NO_MAD ,0.0f
 #endif
 
-// Makro für FilterConfig-Vektor
+// Makro für die FilterConfig-Tabelle eines Pins, beim Kompilieren geprüft
 #define FILTER_ANALOG(pin, threshold, filter_type, length, coeffs, coeffs_len, freq_hz, decay_ms, warmup_ms) \
-  std::vector<FilterConfig> filter_analog_##pin = { \
+  constexpr std::array<FilterConfig, 1> filter_analog_##pin = {{ \
     {filter_type, length, coeffs, coeffs_len, freq_hz, decay_ms, warmup_ms, threshold, 0.0f, VALUE_MODE _TRAILER} \
-  }
+  }}; \
+  DAF_VALIDATE_CONFIGS(filter_analog_##pin)
 
 // Vordefinierte Filter für Szenarien
-const std::vector<FilterConfig> filter_analog_notch = {
-//  {FIR, 5, notch_50hz, 5, 100.0f, 10000, 200, 5.0f, 0.0f, VALUE_MODE _TRAILER} // 50 Hz Notch
-};
+// 50-Hz-Netzbrummen bei 500 Hz Abtastrate: IIR-Kerbe (-3 dB bei 47.5/52.5 Hz) und
+// Butterworth-Tiefpass 4. Ordnung bei 20 Hz, zusammen 3 Sektionen. Ohne Schmitt-
+// Trigger, damit der Filter jedes Sample sieht.
+constexpr auto analog_notch_biquads = biquadChain(biquadNotch(500.0f, 50.0f, 5.0f), biquadButterworthLowPass<2>(500.0f, 20.0f));
+constexpr std::array<FilterConfig, 1> filter_analog_notch = {{
+  {BIQUAD, 0, analog_notch_biquads.data(), analog_notch_biquads.size(), 500.0f, 10000, 200, 0.0f, 0.0f, VALUE_MODE _TRAILER}
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_notch);
 
-const std::vector<FilterConfig> filter_analog_vdiv = {
+constexpr std::array<FilterConfig, 1> filter_analog_vdiv = {{
   {EMA, 10, nullptr, 0, 10.0f, 3600000, 1000, 1.0f, 0.0f, VALUE_MODE _TRAILER}
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_vdiv);
 
-const std::vector<FilterConfig> filter_analog_poti = {
+constexpr std::array<FilterConfig, 1> filter_analog_poti = {{
   {EMA, 10, nullptr, 0, 10.0f, 3600000, 1000, 2.0f, 0.0f, VALUE_MODE _TRAILER}
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_poti);
 
-const std::vector<FilterConfig> filter_analog_sensor = {
+constexpr std::array<FilterConfig, 1> filter_analog_sensor = {{
   {SMA, 10, nullptr, 0, 1.0f, 86400000, 2000, 2.0f, 0.0f, VALUE_MODE _TRAILER}
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_sensor);
 
-const std::vector<FilterConfig> filter_analog_transient = {
+constexpr std::array<FilterConfig, 1> filter_analog_transient = {{
   {FIR, 5, notch_50hz, 5, 100.0f, 1000, 100, 5.0f, 0.0f, VALUE_MODE _TRAILER}
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_transient);
 
-const std::vector<FilterConfig> filter_analog_drift = {
+constexpr std::array<FilterConfig, 1> filter_analog_drift = {{
   {EMA, 20, nullptr, 0, 0.1f, 86400000, 10000, 1.0f, 0.0f, VALUE_MODE _TRAILER}
-};
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_drift);
+
+// ADC mit 1 kHz, Ausgang 10 Hz: CIC (3 Stufen, /10), danach Polyphasen-Tiefpass
+// (/10, -6 dB bei 3 Hz) gegen Aliasing. Jedes Sample wird verarbeitet, ohne Hampel-Vorstufe.
+constexpr auto analog_decimator_lowpass = firLowPass<61>(100.0f, 3.0f);
+constexpr std::array<FilterConfig, 1> filter_analog_fast = {{
+  decimatedConfig({DECIMATE, 0, analog_decimator_lowpass.data(), 61, 1000.0f, 10000, 100, 0.0f, 0.0f, VALUE_MODE _TRAILER_NO_MAD}, 10, 3, 10)
+}};
+DAF_VALIDATE_CONFIGS(filter_analog_fast);
 
 #endif
 